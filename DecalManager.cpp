@@ -0,0 +1,95 @@
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Graphics/DecalSet.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include "DecalManager.h"
+#include "Global.h"
+
+DecalManager::DecalManager(Context* context) :
+	LogicComponent(context)
+{
+	// Only the physics update event is needed: unsubscribe from the rest for optimization
+	SetUpdateEventMask(USE_FIXEDUPDATE);
+}
+
+void DecalManager::RegisterObject(Context* context)
+{
+	context->RegisterFactory<DecalManager>();
+
+	URHO3D_ATTRIBUTE("Max Decals", unsigned, maxDecals_, 256, AM_DEFAULT);
+	URHO3D_ATTRIBUTE("Max Vertices", unsigned, maxVertices_, 16384, AM_DEFAULT);
+	URHO3D_ATTRIBUTE("Life Time", float, lifeTime_, .0f, AM_DEFAULT);
+}
+
+void DecalManager::Start()
+{
+	ResourceCache* cache = GetSubsystem<ResourceCache>();
+	material_ = cache->GetResource<Material>("Materials/BulletHole.xml");
+}
+
+void DecalManager::FixedUpdate(float timeStep)
+{
+	time_ += timeStep;
+
+	if (lifeTime_ <= .0f)
+		return;
+
+	// the manager owns expiry, the sets never time decals out on their own clock
+	while (records_.Size() && time_ - records_.Front().time_ > lifeTime_)
+		RemoveOldest();
+}
+
+bool DecalManager::AddDecal(Drawable * target, const Vector3& position, const Quaternion& rotation, float size)
+{
+	Node * targetNode = target->GetNode();
+	if (!targetNode)
+		return false;
+
+	// check if target scene node already has a DecalSet component. If not, create now
+	DecalSet* decal = targetNode->GetComponent<DecalSet>();
+	if (!decal)
+	{
+		decal = targetNode->CreateComponent<DecalSet>();
+		decal->SetMaterial(material_);
+		decal->SetViewMask(LAYER_EFFECTS);
+
+		// the global budget decides what gets evicted, never let a single set drop decals on its own.
+		// the manager evicts right after a hole is added, so one set never goes past twice the budget
+		decal->SetMaxVertices(maxVertices_ * 2);
+		decal->SetMaxIndices(maxVertices_ * 6);
+	}
+
+	unsigned vertices = decal->GetNumVertices();
+	if (!decal->AddDecal(target, position, rotation, size, 1.0f, 1.0f, Vector2::ZERO, Vector2::ONE))
+		return false;
+
+	// a decal clipped away entirely is dropped by the set, recording it would evict a real hole later
+	if (decal->GetNumVertices() == vertices)
+		return false;
+
+	DecalRecord record;
+	record.decalSet_ = decal;
+	record.vertices_ = decal->GetNumVertices() - vertices;
+	record.time_ = time_;
+	records_.Push(record);
+	numVertices_ += record.vertices_;
+
+	while (records_.Size() > 1 && (records_.Size() > maxDecals_ || numVertices_ > maxVertices_))
+		RemoveOldest();
+
+	return true;
+}
+
+void DecalManager::RemoveOldest()
+{
+	DecalRecord& record = records_.Front();
+
+	// decals are recorded in the order they were added, so the oldest record is also the oldest decal of its set
+	if (record.decalSet_ && record.decalSet_->GetNumDecals())
+		record.decalSet_->RemoveDecals(1);
+
+	numVertices_ -= record.vertices_;
+	records_.Erase(0);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Urho3D/Graphics/DecalSet.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Scene/LogicComponent.h>
+
+using namespace Urho3D;
+
+struct DecalRecord
+{
+	WeakPtr<DecalSet> decalSet_;
+	unsigned vertices_;
+	float time_;
+};
+
+/// Owns every bullet hole in the scene. Keeps a global decal and vertex budget across all DecalSets and evicts the oldest holes first.
+class DecalManager : public LogicComponent
+{
+	URHO3D_OBJECT(DecalManager, LogicComponent);
+
+public:
+	/// Construct.
+	DecalManager(Context* context);
+
+	static void RegisterObject(Context* context);
+	virtual void Start();
+
+	void FixedUpdate(float timeStep);
+
+	/// Paint a bullet hole on the drawable, creating its DecalSet on first use.
+	bool AddDecal(Drawable * target, const Vector3& position, const Quaternion& rotation, float size);
+
+	unsigned GetNumDecals() const { return records_.Size(); }
+	unsigned GetNumVertices() const { return numVertices_; }
+
+	unsigned maxDecals_ = 256;
+	unsigned maxVertices_ = 16384;
+	/// Seconds after which a hole disappears on its own, 0 keeps holes until they are evicted. Holes do not fade out,
+	/// DecalSet has no per decal color or alpha, so expired and evicted holes vanish at once.
+	float lifeTime_ = .0f;
+
+private:
+
+	void RemoveOldest();
+
+	Vector<DecalRecord> records_;
+	unsigned numVertices_ = 0;
+	float time_ = .0f;
+
+	SharedPtr<Material> material_;
+};
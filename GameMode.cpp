@@ -0,0 +1,71 @@
+#include <Urho3D/Scene/Scene.h>
+
+#include "GameMode.h"
+#include "Global.h"
+
+HashMap<StringHash, SharedPtr<GameMode> > GameMode::modes_;
+
+GameMode::GameMode(const String& id, const String& startButton, unsigned scoreSlot, bool timeScored) :
+	id_(id),
+	startButton_(startButton),
+	scoreSlot_(scoreSlot),
+	timeScored_(timeScored)
+{
+}
+
+void GameMode::Register(GameMode * mode)
+{
+	modes_[mode->GetId()] = mode;
+}
+
+GameMode * GameMode::Get(const String& id)
+{
+	HashMap<StringHash, SharedPtr<GameMode> >::ConstIterator i = modes_.Find(id);
+	return i != modes_.End() ? i->second_.Get() : 0;
+}
+
+GameMode * GameMode::GetByStartButton(const String& startButton)
+{
+	for (HashMap<StringHash, SharedPtr<GameMode> >::ConstIterator i = modes_.Begin(); i != modes_.End(); ++i)
+	{
+		if (i->second_->GetStartButton() == startButton)
+			return i->second_;
+	}
+
+	return 0;
+}
+
+bool StartRound(GameMode * mode, Scene * scene)
+{
+	if (!mode || gameState_->GetGameMode())
+		return false;
+
+	gameState_->ResetStats();
+	gameState_->SetGameMode(mode);
+	mode->Start(scene);
+
+	log_->Write(LOG_DEBUG, "Round started: " + mode->GetId());
+	return true;
+}
+
+void EndRound(Scene * scene)
+{
+	GameMode * mode = gameState_->GetGameMode();
+	if (!mode)
+		return;
+
+	gameState_->SetResultText(mode->End(scene));
+
+	// the round is complete now, let it be recorded before its counters are reset
+	VariantMap& eventData = gameState_->GetEventDataMap();
+	eventData[RoundEnded::P_MODE] = mode;
+	gameState_->SendEvent(E_ROUNDENDED, eventData);
+
+	gameState_->SetTimeLeft(.0f);
+	gameState_->ResetStats();
+
+	// leaving the mode last lets listeners see the finished round's result
+	gameState_->SetGameMode(0);
+
+	log_->Write(LOG_DEBUG, "Round ended: " + mode->GetId());
+}
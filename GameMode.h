@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Urho3D/Container/HashMap.h>
+#include <Urho3D/Container/Ptr.h>
+#include <Urho3D/Container/RefCounted.h>
+#include <Urho3D/Container/Str.h>
+#include <Urho3D/Math/StringHash.h>
+
+namespace Urho3D
+{
+	class Scene;
+}
+
+using namespace Urho3D;
+
+class Target;
+
+/// A drill the player starts by shooting its start button. Modes are registered once by id, the running one is kept
+/// in the game state and only its hooks are called, so no code has to compare mode names.
+class GameMode : public RefCounted
+{
+public:
+	/// Construct. The score slot selects the high score table of the mode.
+	GameMode(const String& id, const String& startButton, unsigned scoreSlot, bool timeScored);
+	virtual ~GameMode() {}
+
+	/// Prepare the scene for a new round.
+	virtual void Start(Scene * scene) = 0;
+	/// Advance the round by one physics step.
+	virtual void Tick(Scene * scene, float timeStep) = 0;
+	/// A target took a hit, destroyed tells whether it went down. Called before the target reacts, so a kill that
+	/// ends the round is already scored.
+	virtual void TargetHit(Target * target, float hitDistance, bool destroyed) {}
+	/// A lane target was destroyed or left its lane.
+	virtual void TargetRemoved(Target * target) {}
+	/// Stop the round, set the final score and return the text of the result screen.
+	virtual String End(Scene * scene) = 0;
+	/// Write the text of the HUD timer box into a buffer of the given size.
+	virtual void FormatStatus(char * buffer, unsigned size) const = 0;
+
+	/// How lane targets move in this mode, in meters per second and lane ends reached before they leave (0 = never).
+	virtual float GetTargetSpeed() const { return 6.0f; }
+	virtual unsigned GetTargetBounceLimit() const { return 0; }
+
+	const String& GetId() const { return id_; }
+	const String& GetStartButton() const { return startButton_; }
+	unsigned GetScoreSlot() const { return scoreSlot_; }
+	/// Whether the score is a time in seconds (lower is better) instead of whole points.
+	bool IsTimeScored() const { return timeScored_; }
+
+	static void Register(GameMode * mode);
+	static GameMode * Get(const String& id);
+	static GameMode * GetByStartButton(const String& startButton);
+	static const HashMap<StringHash, SharedPtr<GameMode> >& GetAll() { return modes_; }
+
+private:
+
+	String id_;
+	String startButton_;
+	unsigned scoreSlot_;
+	bool timeScored_;
+
+	static HashMap<StringHash, SharedPtr<GameMode> > modes_;
+};
+
+/// Start a round of a mode. Fails when another round is running.
+bool StartRound(GameMode * mode, Scene * scene);
+/// End the running round and publish its result through the game state.
+void EndRound(Scene * scene);
@@ -0,0 +1,27 @@
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include "GameModeDriver.h"
+#include "Global.h"
+
+GameModeDriver::GameModeDriver(Context* context) :
+	LogicComponent(context)
+{
+	// Rounds are timed in physics steps
+	SetUpdateEventMask(USE_FIXEDUPDATE);
+}
+
+void GameModeDriver::RegisterObject(Context* context)
+{
+	context->RegisterFactory<GameModeDriver>();
+}
+
+void GameModeDriver::FixedUpdate(float timeStep)
+{
+	GameMode * gameMode = gameState_->GetGameMode();
+	if (!gameMode)
+		return;
+
+	gameState_->AdvanceRoundTime(timeStep);
+	gameMode->Tick(GetScene(), timeStep);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Urho3D/Scene/LogicComponent.h>
+
+using namespace Urho3D;
+
+/// Scene component that advances the running game mode every physics step, so the round clock does not depend on the
+/// player's weapon or any other gameplay node.
+class GameModeDriver : public LogicComponent
+{
+	URHO3D_OBJECT(GameModeDriver, LogicComponent);
+
+public:
+	/// Construct.
+	GameModeDriver(Context* context);
+
+	static void RegisterObject(Context* context);
+
+	void FixedUpdate(float timeStep);
+};
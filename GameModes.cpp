@@ -0,0 +1,156 @@
+#include <cmath>
+
+#include <Urho3D/Scene/Scene.h>
+
+#include "GameModes.h"
+#include "HumanTargetController.h"
+#include "ScorePopupSystem.h"
+#include "Target.h"
+#include "TargetController.h"
+#include "Global.h"
+
+TimedRoundMode::TimedRoundMode(const String& id, const String& startButton, unsigned scoreSlot, float targetSpeed, unsigned bounceLimit) :
+	GameMode(id, startButton, scoreSlot, false),
+	targetSpeed_(targetSpeed),
+	bounceLimit_(bounceLimit)
+{
+}
+
+void TimedRoundMode::Start(Scene * scene)
+{
+	for (unsigned int i = 0; i < targetControllers_.Size(); i++)
+		targetControllers_[i]->SetCanCreateTargets(targetControllers_[i]->GetNode()->GetVar("type").GetString() == laneType_);
+
+	gameState_->SetTimeLeft(roundTime_);
+}
+
+void TimedRoundMode::Tick(Scene * scene, float timeStep)
+{
+	if (gameState_->GetTimeLeft() > 0.0f)
+		gameState_->SetTimeLeft(gameState_->GetTimeLeft() - timeStep);
+	else
+		EndRound(scene);
+}
+
+void TimedRoundMode::TargetHit(Target * target, float hitDistance, bool destroyed)
+{
+	if (!destroyed)
+		return;
+
+	// the farther the shot, the more points
+	int points = (int)ceil(hitDistance);
+	target->GetScene()->GetComponent<ScorePopupSystem>()->Show(target->GetNode()->GetWorldPosition(), points);
+	gameState_->AddCounter(GS_POINTS, points);
+}
+
+void TimedRoundMode::TargetRemoved(Target * target)
+{
+	// every lane gets a new target as soon as its last one is gone
+	if (target->GetController())
+		target->GetController()->SetCanCreateTargets(true);
+}
+
+String TimedRoundMode::End(Scene * scene)
+{
+	for (unsigned int i = 0; i < targetControllers_.Size(); i++)
+	{
+		targetControllers_[i]->SetCanCreateTargets(false);
+		targetControllers_[i]->RemoveChilds();
+	}
+
+	int points = gameState_->GetCounter(GS_POINTS);
+	float accuracy = (float)gameState_->GetCounter(GS_SHOTS_HIT) / (float)gameState_->GetCounter(GS_SHOTS_FIRED);
+	char s[20];
+	sprintf(s, "%0.2f", accuracy * 100);
+
+	int finalScore = 0;
+	if (points > 0)
+		finalScore = (int)ceil(points * (accuracy + ((1 - accuracy) / 2)));
+
+	gameState_->SetFinalScore((float)finalScore);
+
+	return
+		"Points earned: " + (String)points + "\n"
+		"Accuracy: " + s + "%\n"
+		"Targets destroyed: " + (String)gameState_->GetCounter(GS_TARGETS_DESTROYED) + "\n\n"
+		"FINAL SCORE: " + (String)finalScore + " !!!";
+}
+
+void TimedRoundMode::FormatStatus(char * buffer, unsigned size) const
+{
+	snprintf(buffer, size, "Time Left: %0.2fs\n", gameState_->GetTimeLeft());
+}
+
+HumanTargetDrillMode::HumanTargetDrillMode(const String& id, const String& startButton, unsigned scoreSlot) :
+	GameMode(id, startButton, scoreSlot, true)
+{
+}
+
+void HumanTargetDrillMode::Start(Scene * scene)
+{
+	// the drill schedules every human target of the scene once
+	numTargets_ = humanTargets_.Size();
+
+	gameState_->SetTimeLeft(.0f);
+	gameState_->SetCounter(GS_TARGETS_LEFT, numTargets_);
+
+	scene->GetComponent<HumanTargetController>()->StartDrill(gameState_->drillSeed_);
+}
+
+void HumanTargetDrillMode::Tick(Scene * scene, float timeStep)
+{
+	// the clock runs up, the round ends when the last target goes down
+	gameState_->SetTimeLeft(gameState_->GetTimeLeft() + timeStep);
+}
+
+void HumanTargetDrillMode::TargetHit(Target * target, float hitDistance, bool destroyed)
+{
+	// shooting a victim costs 10 seconds
+	if (destroyed && target->HT_IsVictim())
+		gameState_->SetTimeLeft(gameState_->GetTimeLeft() + 10.0f);
+}
+
+String HumanTargetDrillMode::End(Scene * scene)
+{
+	scene->GetComponent<HumanTargetController>()->StopDrill();
+
+	float timeLeft = gameState_->GetTimeLeft();
+	float accuracy = (float)gameState_->GetCounter(GS_SHOTS_HIT) / (float)gameState_->GetCounter(GS_SHOTS_FIRED);
+	char s[20];
+	sprintf(s, "%0.2f", accuracy * 100);
+	String str = s;
+
+	float finalScore = 0.0f;
+	finalScore = timeLeft / (accuracy + ((1 - accuracy) / 2));
+
+	sprintf(s, "%0.2f", timeLeft);
+	String str2 = s;
+
+	sprintf(s, "%0.2f", finalScore - timeLeft);
+	String str3 = s;
+
+	sprintf(s, "%0.2f", finalScore);
+	String str4 = s;
+
+	gameState_->SetFinalScore(finalScore);
+
+	return
+		"Time elapsed: " + str2 + "s\n"
+		"Accuracy: " + str + "%\n"
+		"Penalty: " + str3 + "s\n"
+		"Targets destroyed: " + (String)gameState_->GetCounter(GS_TARGETS_DESTROYED) + "\n\n"
+		"FINAL SCORE: " + str4 + " !!!";
+}
+
+void HumanTargetDrillMode::FormatStatus(char * buffer, unsigned size) const
+{
+	snprintf(buffer, size, "Time Elapsed: %0.2fs\nTargets: %d / %u",
+		gameState_->GetTimeLeft(), gameState_->GetCounter(GS_TARGETS_LEFT), numTargets_);
+}
+
+void RegisterGameModes()
+{
+	GameMode::Register(new TimedRoundMode("mode_1", "start_button_1", 0, 6.0f, 0));
+	GameMode::Register(new TimedRoundMode("mode_2", "start_button_2", 1, 9.0f, 2));
+	GameMode::Register(new HumanTargetDrillMode("mode_3", "start_button_4", 2));
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "GameMode.h"
+
+/// 30 second round on the moving target lanes. Points depend on the shot distance and are scaled by accuracy.
+class TimedRoundMode : public GameMode
+{
+public:
+	/// Construct. Lanes whose controller node has the lane type in its "type" variable spawn targets.
+	TimedRoundMode(const String& id, const String& startButton, unsigned scoreSlot, float targetSpeed, unsigned bounceLimit);
+
+	virtual void Start(Scene * scene);
+	virtual void Tick(Scene * scene, float timeStep);
+	virtual void TargetHit(Target * target, float hitDistance, bool destroyed);
+	virtual void TargetRemoved(Target * target);
+	virtual String End(Scene * scene);
+	virtual void FormatStatus(char * buffer, unsigned size) const;
+
+	virtual float GetTargetSpeed() const { return targetSpeed_; }
+	virtual unsigned GetTargetBounceLimit() const { return bounceLimit_; }
+
+	float roundTime_ = 30.0f;
+	String laneType_ = "mode_1";
+
+private:
+
+	float targetSpeed_;
+	unsigned bounceLimit_;
+};
+
+/// Human targets pop up in seeded waves; the score is the elapsed time scaled by accuracy, lower is better.
+class HumanTargetDrillMode : public GameMode
+{
+public:
+	/// Construct.
+	HumanTargetDrillMode(const String& id, const String& startButton, unsigned scoreSlot);
+
+	virtual void Start(Scene * scene);
+	virtual void Tick(Scene * scene, float timeStep);
+	virtual void TargetHit(Target * target, float hitDistance, bool destroyed);
+	virtual String End(Scene * scene);
+	virtual void FormatStatus(char * buffer, unsigned size) const;
+
+private:
+
+	/// Human targets of the running drill, every one of them pops up once.
+	unsigned numTargets_ = 0;
+};
+
+/// Register the drills of the range. Has to run before the start button hit handlers are registered.
+void RegisterGameModes();
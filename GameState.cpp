@@ -0,0 +1,70 @@
+#include <Urho3D/Core/Context.h>
+
+#include "GameState.h"
+
+GameState::GameState(Context* context) :
+	Object(context)
+{
+	for (unsigned int i = 0; i < MAX_GAME_COUNTERS; i++)
+		counters_[i] = 0;
+}
+
+void GameState::SetCounter(GameStateField counter, int value)
+{
+	if (counters_[counter] == value)
+		return;
+
+	counters_[counter] = value;
+	Notify(counter);
+}
+
+void GameState::ResetStats()
+{
+	SetCounter(GS_SHOTS_FIRED, 0);
+	SetCounter(GS_SHOTS_HIT, 0);
+	SetCounter(GS_TARGETS_DESTROYED, 0);
+	SetCounter(GS_TARGETS_MISSED, 0);
+	SetCounter(GS_POINTS, 0);
+}
+
+void GameState::SetGameMode(GameMode * mode)
+{
+	if (gameMode_ == mode)
+		return;
+
+	if (gameMode_)
+		lastMode_ = gameMode_;
+
+	gameMode_ = mode;
+	if (gameMode_)
+		roundTime_ = .0f;
+
+	Notify(GS_GAME_MODE);
+}
+
+void GameState::SetFinalScore(float score)
+{
+	if (finalScore_ == score)
+		return;
+
+	finalScore_ = score;
+	Notify(GS_FINAL_SCORE);
+}
+
+void GameState::SetSelectedWeapon(int index)
+{
+	if (selectedWeapon_ == index)
+		return;
+
+	selectedWeapon_ = index;
+	Notify(GS_SELECTED_WEAPON);
+}
+
+void GameState::Notify(GameStateField field)
+{
+	using namespace GameStateChanged;
+
+	VariantMap& eventData = GetEventDataMap();
+	eventData[P_FIELD] = (int)field;
+	SendEvent(E_GAMESTATECHANGED, eventData);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <Urho3D/Core/Object.h>
+
+using namespace Urho3D;
+
+class GameMode;
+
+/// A game state value has changed. Only sent when the new value differs from the old one. The round clock changes on
+/// every physics step and is not sent, read it with GetTimeLeft() instead.
+URHO3D_EVENT(E_GAMESTATECHANGED, GameStateChanged)
+{
+	URHO3D_PARAM(P_FIELD, Field);	// int, GameStateField
+}
+
+/// A round has ended. Sent before its counters are reset.
+URHO3D_EVENT(E_ROUNDENDED, RoundEnded)
+{
+	URHO3D_PARAM(P_MODE, Mode);		// GameMode pointer
+}
+
+enum GameStateField
+{
+	// counters
+	GS_SHOTS_FIRED = 0,
+	GS_SHOTS_HIT,
+	GS_TARGETS_DESTROYED,
+	GS_TARGETS_MISSED,
+	GS_POINTS,
+	GS_TARGETS_LEFT,
+	MAX_GAME_COUNTERS,
+
+	GS_GAME_MODE = MAX_GAME_COUNTERS,
+	GS_FINAL_SCORE,
+	GS_SELECTED_WEAPON
+};
+
+/// State of the running session: game mode, round clock, score counters and the selected weapon.
+class GameState : public Object
+{
+	URHO3D_OBJECT(GameState, Object);
+
+public:
+	/// Construct.
+	GameState(Context* context);
+
+	int GetCounter(GameStateField counter) const { return counters_[counter]; }
+	void SetCounter(GameStateField counter, int value);
+	void AddCounter(GameStateField counter, int amount = 1) { SetCounter(counter, counters_[counter] + amount); }
+	/// Zero the counters of a round. The targets left counter belongs to the human target drill and is kept.
+	void ResetStats();
+
+	/// Running game mode, null between rounds.
+	GameMode * GetGameMode() const { return gameMode_; }
+	/// Mode of the last finished round.
+	GameMode * GetLastMode() const { return lastMode_; }
+	/// Switch the game mode. Leaving a mode remembers it as the last mode.
+	void SetGameMode(GameMode * mode);
+
+	/// Result screen text of the last finished round.
+	const String& GetResultText() const { return resultText_; }
+	void SetResultText(const String& text) { resultText_ = text; }
+
+	/// Game time since the running mode started, advanced with the mode ticks.
+	float GetRoundTime() const { return roundTime_; }
+	void AdvanceRoundTime(float timeStep) { roundTime_ += timeStep; }
+
+	float GetTimeLeft() const { return timeLeft_; }
+	void SetTimeLeft(float time) { timeLeft_ = time; }
+
+	float GetFinalScore() const { return finalScore_; }
+	void SetFinalScore(float score);
+
+	int GetSelectedWeapon() const { return selectedWeapon_; }
+	void SetSelectedWeapon(int index);
+
+	/// Settings read at startup, they do not change during a session.
+	int primaryWeapon_ = 0;
+	int secondaryWeapon_ = 1;
+	String shotLightQuality_ = "high";
+	unsigned drillSeed_ = 0;
+
+private:
+
+	void Notify(GameStateField field);
+
+	int counters_[MAX_GAME_COUNTERS];
+	GameMode * gameMode_ = 0;
+	GameMode * lastMode_ = 0;
+	String resultText_;
+	float roundTime_ = .0f;
+	float timeLeft_ = .0f;
+	float finalScore_ = .0f;
+	int selectedWeapon_ = 0;
+};
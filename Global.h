@@ -1,12 +1,26 @@
 #pragma once
 
 #include <Urho3D/IO/Log.h>
+#include "GameMode.h"
+#include "GameState.h"
+#include "IoWorker.h"
 #include "TargetController.h"
 #include "Target.h"
+#include "WeaponDef.h"
+
+// view mask layers, bullets are only tested against SHOOTABLE_LAYERS
+const unsigned LAYER_WORLD = 0x1;
+const unsigned LAYER_TARGETS = 0x2;
+const unsigned LAYER_PLAYER = 0x4;
+const unsigned LAYER_EFFECTS = 0x8;
+// render meshes that have a hit proxy, and the proxies themselves (never drawn)
+const unsigned LAYER_PROXIED = 0x10;
+const unsigned LAYER_HITPROXY = 0x20;
+const unsigned SHOOTABLE_LAYERS = LAYER_WORLD | LAYER_TARGETS | LAYER_HITPROXY;
 
 extern Log * log_;
-extern HashMap<String, VariantMap> weaponsData_;
-extern VariantMap gameVars_;
-extern VariantMap gameStats_;
+extern Vector<WeaponDef> weaponDefs_;
+extern GameState * gameState_;
+extern IoWorker * ioWorker_;
 extern Vector<TargetController*> targetControllers_;
 extern Vector<Target*> humanTargets_;
\ No newline at end of file
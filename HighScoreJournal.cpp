@@ -0,0 +1,186 @@
+#include <cstddef>
+#include <cstring>
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/VectorBuffer.h>
+
+#include "HighScoreJournal.h"
+#include "IoWorker.h"
+#include "Global.h"
+
+static const unsigned JOURNAL_VERSION = 1;
+/// File id, version and record size.
+static const unsigned HEADER_SIZE = 12;
+
+static unsigned CalculateChecksum(const HighScoreRecord& record)
+{
+	// FNV-1a over everything but the checksum itself
+	const unsigned char* data = (const unsigned char*)&record;
+	unsigned hash = 2166136261u;
+	for (unsigned i = 0; i < offsetof(HighScoreRecord, checksum_); i++)
+		hash = (hash ^ data[i]) * 16777619u;
+
+	return hash;
+}
+
+static HighScoreRecord MakeRecord(const String& name, float score)
+{
+	HighScoreRecord record;
+	memset(&record, 0, sizeof(record));
+
+	unsigned length = name.Length() < sizeof(record.name_) - 1 ? name.Length() : sizeof(record.name_) - 1;
+	memcpy(record.name_, name.CString(), length);
+	record.score_ = score;
+	record.checksum_ = CalculateChecksum(record);
+
+	return record;
+}
+
+HighScoreJournal::HighScoreJournal(Context* context) :
+	Object(context)
+{
+}
+
+void HighScoreJournal::Open(const String& fileName, const String& legacyNamesFile, const String& legacyPointsFile)
+{
+	fileName_ = fileName;
+	records_.Clear();
+	appendOffset_ = HEADER_SIZE;
+	needsCompaction_ = false;
+
+	FileSystem* fileSystem = GetSubsystem<FileSystem>();
+	fileSystem->CreateDir(GetPath(fileName_));
+
+	if (fileSystem->FileExists(fileName_))
+	{
+		if (!Load())
+		{
+			// unreadable header, start over rather than appending to garbage
+			records_.Clear();
+			needsCompaction_ = true;
+		}
+	}
+	else
+	{
+		LoadLegacy(legacyNamesFile, legacyPointsFile);
+		needsCompaction_ = true;
+	}
+
+	if (needsCompaction_)
+		StartCompaction();
+}
+
+void HighScoreJournal::Append(const String& name, float score)
+{
+	HighScoreRecord record = MakeRecord(name, score);
+	records_.Push(record);
+
+	ioWorker_->Post(IO_WRITE_AT, fileName_, &record, sizeof(HighScoreRecord), appendOffset_);
+	appendOffset_ += sizeof(HighScoreRecord);
+}
+
+bool HighScoreJournal::Load()
+{
+	File file(context_, fileName_, FILE_READ);
+	if (!file.IsOpen() || file.GetSize() < HEADER_SIZE)
+		return false;
+
+	if (file.ReadFileID() != "SRHJ" || file.ReadUInt() != JOURNAL_VERSION || file.ReadUInt() != sizeof(HighScoreRecord))
+	{
+		log_->Write(LOG_ERROR, "Unsupported high score journal " + fileName_);
+		return false;
+	}
+
+	unsigned numRecords = (file.GetSize() - HEADER_SIZE) / sizeof(HighScoreRecord);
+	records_.Resize(numRecords);
+	if (numRecords)
+		file.Read(&records_[0], numRecords * sizeof(HighScoreRecord));
+
+	appendOffset_ = HEADER_SIZE + numRecords * sizeof(HighScoreRecord);
+	if (appendOffset_ != file.GetSize())
+		needsCompaction_ = true;
+
+	// drop records that were torn or damaged
+	unsigned valid = 0;
+	for (unsigned i = 0; i < numRecords; i++)
+	{
+		if (CalculateChecksum(records_[i]) == records_[i].checksum_ && records_[i].name_[sizeof(records_[i].name_) - 1] == 0)
+			records_[valid++] = records_[i];
+	}
+
+	if (valid != numRecords)
+	{
+		log_->Write(LOG_WARNING, "Skipped " + String(numRecords - valid) + " damaged records in " + fileName_);
+		records_.Resize(valid);
+		needsCompaction_ = true;
+	}
+
+	return true;
+}
+
+void HighScoreJournal::LoadLegacy(const String& namesFile, const String& pointsFile)
+{
+	if (namesFile.Empty() || pointsFile.Empty())
+		return;
+
+	File file(context_);
+	if (!file.Open(namesFile, FILE_READ))
+		return;
+	StringVector names = file.ReadStringVector();
+	file.Close();
+
+	if (!file.Open(pointsFile, FILE_READ))
+		return;
+	VariantVector points = file.ReadVariantVector();
+	file.Close();
+
+	// the two files were written one after the other and may not have the same length
+	unsigned count = names.Size() < points.Size() ? names.Size() : points.Size();
+	for (unsigned i = 0; i < count; i++)
+	{
+		float score = points[i].GetType() == VAR_FLOAT ? points[i].GetFloat() : (float)points[i].GetInt();
+		records_.Push(MakeRecord(names[i], score));
+	}
+
+	legacyNamesFile_ = namesFile;
+	legacyPointsFile_ = pointsFile;
+}
+
+void HighScoreJournal::StartCompaction()
+{
+	needsCompaction_ = false;
+
+	VectorBuffer buffer;
+	buffer.WriteFileID("SRHJ");
+	buffer.WriteUInt(JOURNAL_VERSION);
+	buffer.WriteUInt(sizeof(HighScoreRecord));
+	if (records_.Size())
+		buffer.Write(&records_[0], records_.Size() * sizeof(HighScoreRecord));
+
+	ioWorker_->Post(IO_REPLACE, fileName_, buffer.GetData(), buffer.GetSize(), 0, HandleCompacted, this);
+
+	// later appends are queued behind the replace and go to the new file
+	appendOffset_ = HEADER_SIZE + records_.Size() * sizeof(HighScoreRecord);
+}
+
+void HighScoreJournal::HandleCompacted(void * owner, bool success)
+{
+	HighScoreJournal* journal = (HighScoreJournal*)owner;
+	if (!success)
+	{
+		log_->Write(LOG_ERROR, "Could not compact high score journal " + journal->fileName_);
+		return;
+	}
+
+	// the old files are only removed once their scores are safely in the journal
+	if (!journal->legacyNamesFile_.Empty())
+	{
+		ioWorker_->Post(IO_DELETE, journal->legacyNamesFile_);
+		ioWorker_->Post(IO_DELETE, journal->legacyPointsFile_);
+		journal->legacyNamesFile_.Clear();
+		journal->legacyPointsFile_.Clear();
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Urho3D/Core/Object.h>
+
+using namespace Urho3D;
+
+/// One saved score as it is stored in the journal file.
+struct HighScoreRecord
+{
+	/// Player name, zero terminated.
+	char name_[16];
+	float score_;
+	/// Hash of name and score, a record torn by a crash does not match it.
+	unsigned checksum_;
+};
+
+/// High scores of one score slot, kept in a binary file of fixed-size records. Saving a score appends one record, so the
+/// file never has to be rewritten. Torn or corrupt records are skipped while loading and removed by a compaction that
+/// writes a new file and atomically replaces the old one. All writes go through the I/O worker in the order they are
+/// made, so appends made during a compaction land in the new file.
+class HighScoreJournal : public Object
+{
+	URHO3D_OBJECT(HighScoreJournal, Object);
+
+public:
+	/// Construct.
+	HighScoreJournal(Context* context);
+
+	/// Load the journal. When it does not exist yet, the old names and points files of the slot are converted.
+	void Open(const String& fileName, const String& legacyNamesFile = String::EMPTY, const String& legacyPointsFile = String::EMPTY);
+	/// Append a score. It is written and flushed in the background.
+	void Append(const String& name, float score);
+
+	const PODVector<HighScoreRecord>& GetRecords() const { return records_; }
+
+private:
+
+	bool Load();
+	void LoadLegacy(const String& namesFile, const String& pointsFile);
+	void StartCompaction();
+
+	static void HandleCompacted(void * owner, bool success);
+
+	String fileName_;
+	/// Offset of the record after the last valid one. Appends overwrite a torn tail.
+	unsigned appendOffset_ = 0;
+	bool needsCompaction_ = false;
+	PODVector<HighScoreRecord> records_;
+
+	/// Old files to delete once the first compaction has written their scores.
+	String legacyNamesFile_;
+	String legacyPointsFile_;
+};
@@ -0,0 +1,47 @@
+#include <Urho3D/Audio/Sound.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include "GameMode.h"
+#include "HitHandlers.h"
+#include "HumanTargetController.h"
+#include "Shootable.h"
+#include "SoundPool.h"
+#include "Target.h"
+#include "Global.h"
+
+/// Impact sound of every target hit, looked up on the first hit only. Weak, the cache owns it.
+static WeakPtr<Sound> hitSound;
+
+static bool HandleTargetHit(Shootable * shootable, const ShotHit& hit)
+{
+	Target * target = shootable->GetComponent<Target>();
+	if (target)
+		target->RegisterHit(20.0f, hit.distance_);
+
+	gameState_->AddCounter(GS_SHOTS_HIT);
+
+	// the only place a target hit plays a sound, a kill included
+	if (!hitSound)
+		hitSound = shootable->GetSubsystem<ResourceCache>()->GetResource<Sound>("Sounds/metal.wav");
+	shootable->GetScene()->GetComponent<SoundPool>()->Play(hitSound, VOICE_IMPACT);
+
+	return true;
+}
+
+static bool HandleStartButton(Shootable * shootable, const ShotHit& hit)
+{
+	// while a round is running the button is just a wall and keeps the bullet hole
+	return StartRound(GameMode::GetByStartButton(shootable->GetKind()), shootable->GetScene());
+}
+
+void RegisterHitHandlers()
+{
+	Shootable::RegisterHandler("box", HandleTargetHit);
+	Shootable::RegisterHandler("human_target", HandleTargetHit);
+
+	// every registered game mode is started by its own button
+	const HashMap<StringHash, SharedPtr<GameMode> >& modes = GameMode::GetAll();
+	for (HashMap<StringHash, SharedPtr<GameMode> >::ConstIterator i = modes.Begin(); i != modes.End(); ++i)
+		Shootable::RegisterHandler(i->second_->GetStartButton(), HandleStartButton);
+}
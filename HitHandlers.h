@@ -0,0 +1,4 @@
+#pragma once
+
+/// Register hit handlers of all built-in shootable kinds: targets and the start buttons of the registered game modes.
+void RegisterHitHandlers();
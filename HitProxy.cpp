@@ -0,0 +1,49 @@
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Node.h>
+
+#include "HitProxy.h"
+#include "Global.h"
+
+StaticModel * AttachHitProxy(StaticModel * visual)
+{
+	Model * model = visual->GetModel();
+	Node * node = visual->GetNode();
+	if (!model || !node)
+		return 0;
+
+	ResourceCache* cache = visual->GetSubsystem<ResourceCache>();
+	String proxyName = ReplaceExtension(model->GetName(), "_hit.mdl");
+	if (!cache->Exists(proxyName))
+		return 0;
+
+	StaticModel * proxy = node->CreateComponent<StaticModel>();
+	proxy->SetModel(cache->GetResource<Model>(proxyName));
+	proxy->SetCastShadows(false);
+	proxy->SetViewMask(LAYER_HITPROXY);
+
+	// the render mesh stays visible but is no longer tested by bullets
+	visual->SetViewMask(LAYER_PROXIED);
+
+	return proxy;
+}
+
+Drawable * GetVisualForHit(Drawable * hitDrawable)
+{
+	if (!(hitDrawable->GetViewMask() & LAYER_HITPROXY))
+		return hitDrawable;
+
+	PODVector<StaticModel *> models;
+	hitDrawable->GetNode()->GetComponents<StaticModel>(models);
+
+	for (unsigned int i = 0; i < models.Size(); i++)
+	{
+		if (models[i]->GetViewMask() & LAYER_PROXIED)
+			return models[i];
+	}
+
+	return hitDrawable;
+}
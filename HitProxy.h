@@ -0,0 +1,11 @@
+#pragma once
+
+#include <Urho3D/Graphics/StaticModel.h>
+
+using namespace Urho3D;
+
+/// Attach the low-poly hit proxy authored next to the model ("Models/name.mdl" -> "Models/name_hit.mdl"), if there is one.
+/// Bullets are then tested against the proxy while only the render mesh is drawn. Returns the proxy or null.
+StaticModel * AttachHitProxy(StaticModel * visual);
+/// Return the drawable that should receive bullet holes for a hit on the given drawable.
+Drawable * GetVisualForHit(Drawable * hitDrawable);
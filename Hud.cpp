@@ -0,0 +1,99 @@
+#include <cmath>
+#include <cstdio>
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/UI/Font.h>
+#include <Urho3D/UI/UI.h>
+
+#include "Hud.h"
+#include "Global.h"
+
+Hud::Hud(Context* context) :
+	Object(context)
+{
+	ResourceCache* cache = GetSubsystem<ResourceCache>();
+	UI* ui = GetSubsystem<UI>();
+	Font* font = cache->GetResource<Font>("Fonts/Prototype.ttf");
+
+	pointsText_ = ui->GetRoot()->CreateChild<Text>();
+	pointsText_->SetFont(font, 20);
+	pointsText_->SetTextAlignment(HA_LEFT);
+	pointsText_->SetPosition(10, 10);
+
+	timerText_ = ui->GetRoot()->CreateChild<Text>();
+	timerText_->SetFont(font, 20);
+	timerText_->SetTextAlignment(HA_RIGHT);
+	timerText_->SetPosition(-10, 10);
+	timerText_->SetAlignment(HA_RIGHT, VA_TOP);
+
+	// reserve once so formatting never reallocates
+	text_.Reserve(sizeof(buffer_));
+
+	SubscribeToEvent(gameState_, E_GAMESTATECHANGED, URHO3D_HANDLER(Hud, HandleGameStateChanged));
+	SubscribeToEvent(E_UPDATE, URHO3D_HANDLER(Hud, HandleUpdate));
+}
+
+void Hud::HandleGameStateChanged(StringHash eventType, VariantMap& eventData)
+{
+	using namespace GameStateChanged;
+
+	switch (eventData[P_FIELD].GetInt())
+	{
+	case GS_POINTS:
+	case GS_SHOTS_FIRED:
+	case GS_TARGETS_DESTROYED:
+		pointsDirty_ = true;
+		break;
+
+	case GS_GAME_MODE:
+	case GS_TARGETS_LEFT:
+		timerDirty_ = true;
+		break;
+	}
+}
+
+void Hud::HandleUpdate(StringHash eventType, VariantMap& eventData)
+{
+	if (pointsDirty_)
+		UpdatePoints();
+
+	// the round clock sends no event, poll it once per frame. only every hundredth of a second is visible
+	if (gameState_->GetGameMode() && (int)floorf(gameState_->GetTimeLeft() * 100.0f + 0.5f) != shownTime_)
+		timerDirty_ = true;
+
+	if (timerDirty_)
+		UpdateTimer();
+}
+
+void Hud::UpdatePoints()
+{
+	pointsDirty_ = false;
+
+	snprintf(buffer_, sizeof(buffer_),
+		"Points: %d\n"
+		"Shots Fired: %d\n"
+		"Targets Hit: %d\n",
+		gameState_->GetCounter(GS_POINTS),
+		gameState_->GetCounter(GS_SHOTS_FIRED),
+		gameState_->GetCounter(GS_TARGETS_DESTROYED));
+
+	text_ = buffer_;
+	pointsText_->SetText(text_);
+}
+
+void Hud::UpdateTimer()
+{
+	timerDirty_ = false;
+	shownTime_ = (int)floorf(gameState_->GetTimeLeft() * 100.0f + 0.5f);
+
+	GameMode * gameMode = gameState_->GetGameMode();
+	if (gameMode)
+		gameMode->FormatStatus(buffer_, sizeof(buffer_));
+	else
+		buffer_[0] = 0;
+
+	text_ = buffer_;
+	timerText_->SetText(text_);
+}
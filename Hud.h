@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/UI/Text.h>
+
+using namespace Urho3D;
+
+/// Score and timer boxes in the screen corners. Game state changes only mark a box dirty, and the round clock is polled
+/// once per frame; a dirty box is formatted into a preallocated buffer and laid out at most once per rendered frame, so
+/// an idle HUD costs nothing.
+class Hud : public Object
+{
+	URHO3D_OBJECT(Hud, Object);
+
+public:
+	/// Construct and create the texts under the UI root.
+	Hud(Context* context);
+
+private:
+
+	void HandleGameStateChanged(StringHash eventType, VariantMap& eventData);
+	void HandleUpdate(StringHash eventType, VariantMap& eventData);
+
+	void UpdatePoints();
+	void UpdateTimer();
+
+	Text * pointsText_;
+	Text * timerText_;
+
+	bool pointsDirty_ = true;
+	bool timerDirty_ = true;
+	/// Round clock in hundredths of a second as it is shown, the timer is not touched until this changes.
+	int shownTime_ = 0;
+
+	char buffer_[128];
+	String text_;
+};
@@ -13,13 +13,23 @@
 
 #include "Target.h"
 #include "HumanTargetController.h"
+#include "TweenSystem.h"
 #include "Global.h"
 
+/// Raising time and height of a human target.
+static const float HT_RAISE_TIME = .5f;
+static const float HT_RAISE_HEIGHT = 1.5f;
+
+static void HandleTargetRaised(Node * node)
+{
+	log_->Write(LOG_DEBUG, "Human target raised: " + node->GetPosition().ToString());
+}
+
 HumanTargetController::HumanTargetController(Context* context) :
 	LogicComponent(context)
 {
-	// Only the physics update event is needed: unsubscribe from the rest for optimization
-	SetUpdateEventMask(USE_FIXEDUPDATE);
+	// The pop-up motion is driven by the tween system, no update events are needed
+	SetUpdateEventMask(0);
 }
 
 void HumanTargetController::RegisterObject(Context* context)
@@ -30,124 +40,105 @@ void HumanTargetController::RegisterObject(Context* context)
 void HumanTargetController::Start()
 {
 	log_->Write(LOG_DEBUG, "Human Target Controller created");
-	targetsLeft_ = humanTargets_;
-}
 
-void HumanTargetController::Setup(Vector<Window *> * wh, Sprite * wc, Window * rw, Text * rt)
-{
-	wh_ = wh;
-	weaponCrosshair_ = wc;
-	resultWindow_ = rw;
-	resultText_ = rt;
+	for (unsigned int i = 0; i < humanTargets_.Size(); i++)
+		normalMaterials_.Push(SharedPtr<Material>(humanTargets_[i]->GetComponent<StaticModel>()->GetMaterial(1)));
 }
 
-void HumanTargetController::ShowTarget()
+void HumanTargetController::StartDrill(unsigned seed)
 {
-	if (targetsLeft_.Size() < 1 || gameVars_["gameMode"].GetString() != "mode_3" || !canShowTarget)
+	if (!seed)
+		seed = Time::GetSystemTime();
+
+	schedule_ = std::priority_queue<ScheduledTarget, std::vector<ScheduledTarget>, LaterTarget>();
+	drillTime_ = .0f;
+
+	unsigned numTargets = humanTargets_.Size();
+	if (!numTargets)
 		return;
 
-	if (firstTarget_)
-	{
-		innocentTargets_ = 2;
-		firstTarget_ = false;
+	// the whole drill is drawn from one seed up front: pop-up order, victims and timing
+	SetRandomSeed(seed);
+
+	PODVector<unsigned> order(numTargets);
+	for (unsigned int i = 0; i < numTargets; i++)
+		order[i] = i;
+	for (unsigned int i = numTargets - 1; i > 0; i--)
+		Swap(order[i], order[Random(0, (int)i + 1)]);
 
+	PODVector<bool> victims(numTargets);
+	for (unsigned int i = 0; i < numTargets; i++)
+		victims[i] = false;
+	for (unsigned int i = 0; i < victims_ && i < numTargets; i++)
+	{
+		unsigned pick = Random(0, (int)numTargets);
+		while (victims[pick])
+			pick = (pick + 1) % numTargets;
+		victims[pick] = true;
 	}
 
-	SetRandomSeed(Time::GetSystemTime());
-	int rand = Random(0, targetsLeft_.Size());
-	targetToMove = rand;
-	canShowTarget = false;
-	Node * node = targetsLeft_.At(rand)->GetNode();
-	heightToMove = node->GetPosition().y_ + 1.5f;
-
-	ResourceCache* cache = GetSubsystem<ResourceCache>();
-	StaticModel * model = node->GetComponent<StaticModel>();
-	SetRandomSeed(Time::GetSystemTime());
-	int victim = Random(0, 3);
-
-	if (victim == 1 && innocentTargets_ > 0)
-	{	
-		model->SetMaterial(1, cache->GetResource<Material>("Materials/victim.xml"));
-		innocentTargets_--;
-		targetsLeft_.At(rand)->HT_SetVictim(true);
+	for (unsigned int i = 0; i < numTargets; i++)
+	{
+		unsigned wave = i / Max(waveSize_, 1U);
+		unsigned slot = i % Max(waveSize_, 1U);
+
+		ScheduledTarget entry;
+		entry.time_ = wave * waveInterval_ + slot * waveStagger_ + Random(.0f, waveJitter_);
+		entry.target_ = order[i];
+		entry.upTime_ = Max(upTime_ - wave * upTimeDecay_, minUpTime_);
+		entry.victim_ = victims[i];
+		schedule_.push(entry);
+
+		Target * target = humanTargets_[order[i]];
+		target->HT_SetVictim(entry.victim_);
+		target->GetComponent<StaticModel>()->SetMaterial(1, normalMaterials_[order[i]]);
 	}
 
-	targetsLeft_.At(rand)->HT_SetHT(true);
-	targetsLeft_.At(rand)->HT_SetActive(true);
-	targetsLeft_.At(rand)->SetHealth(10.0f);
+	SetUpdateEventMask(USE_FIXEDUPDATE);
 
-	log_->Write(LOG_DEBUG, "Human Targets Left: " + (String)targetsLeft_.Size() + " rand: " + (String)rand + " victim: " + (String)victim);
+	log_->Write(LOG_INFO, "Human target drill started, seed: " + (String)seed);
 }
 
 void HumanTargetController::FixedUpdate(float timeStep)
 {
-	if (gameVars_["gameMode"].GetString() != "mode_3" || targetToMove == -1)
-		return;
+	drillTime_ += timeStep;
 
-	Node * node = targetsLeft_.At(targetToMove)->GetNode();
-	log_->Write(LOG_DEBUG, "htm: " + (String)heightToMove + " vec: " + (String)node->GetPosition().ToString());
-	if(node->GetPosition().y_ < heightToMove)
-		node->Translate(Vector3(-.05f, .0f, .0f), TS_LOCAL);
-	else
+	while (!schedule_.empty() && schedule_.top().time_ <= drillTime_)
 	{
-		targetsLeft_.Erase(targetToMove);
-		targetToMove = -1;
-		log_->Write(LOG_DEBUG, "Human Target removed rand: " + (String)targetToMove);
+		ShowTarget(schedule_.top());
+		schedule_.pop();
 	}
-}
 
-void HumanTargetController::SetCanShowTarget(bool toogle)
-{
-	canShowTarget = true;
+	// nothing left to raise, stay out of the update until the next drill
+	if (schedule_.empty())
+		SetUpdateEventMask(0);
 }
 
-void HumanTargetController::EndGame()
+void HumanTargetController::ShowTarget(const ScheduledTarget& entry)
 {
-	Input* input = GetSubsystem<Input>();
-
-	gameVars_["lastMode"] = gameVars_["gameMode"];
-	gameVars_["gameMode"] = "none";
-
-	float accuracy = gameStats_["shotsHit"].GetFloat() / gameStats_["shotsFired"].GetFloat();
-	char s[20];
-	sprintf(s, "%0.2f", accuracy * 100);
-	String str = s;
-
-	float finalScore = 0.0f;
-	finalScore = gameVars_["timeLeft"].GetFloat() / (accuracy + ((1 - accuracy) / 2));
-
-	sprintf(s, "%0.2f", gameVars_["timeLeft"].GetFloat());
-	String str2 = s;
-
-	sprintf(s, "%0.2f", finalScore - gameVars_["timeLeft"].GetFloat());
-	String str3 = s;
-
-	sprintf(s, "%0.2f", finalScore);
-	String str4 = s;
-
-	resultText_->SetText(
-		"Time elapsed: " + str2 + "s\n"
-		"Accuracy: " + str + "%\n"
-		"Penalty: " + str3 + "s\n"
-		"Targets destroyed: " + (String)gameStats_["targetsDestroyed"] + "\n\n"
-		"FINAL SCORE: " + str4 + " !!!"
-	);
-
-	gameVars_["timeLeft"] = 0.0f;
-	gameVars_["tempPoints"] = finalScore;
-	gameStats_["shotsFired"] = 0;
-	gameStats_["shotsHit"] = 0;
-	gameStats_["targetsDestroyed"] = 0;
-	gameStats_["targetMissed"] = 0;
-	gameStats_["points"] = 0;
-
-	resultWindow_->SetVisible(true);
-	wh_->Push(resultWindow_);
-	input->SetMouseVisible(true);
-	weaponCrosshair_->SetVisible(false);
+	Target * target = humanTargets_[entry.target_];
+	Node * node = target->GetNode();
+
+	if (entry.victim_)
+	{
+		ResourceCache* cache = GetSubsystem<ResourceCache>();
+		node->GetComponent<StaticModel>()->SetMaterial(1, cache->GetResource<Material>("Materials/victim.xml"));
+	}
+
+	target->HT_SetHT(true);
+	target->HT_SetUpTime(entry.upTime_);
+	target->HT_SetActive(true);
+	target->SetHealth(10.0f);
+
+	// the target stands up along its local -X axis
+	Vector3 raised = node->GetPosition() + node->GetRotation() * Vector3(-HT_RAISE_HEIGHT, .0f, .0f);
+	GetScene()->GetComponent<TweenSystem>()->MoveTo(node, raised, HT_RAISE_TIME, EASE_OUT_BACK, .0f, 0, HandleTargetRaised);
+
+	log_->Write(LOG_DEBUG, "Human target shown: " + (String)entry.target_ + " victim: " + (String)entry.victim_ + " pending: " + (String)(unsigned)schedule_.size());
 }
 
-void HumanTargetController::ResetTargets()
+void HumanTargetController::StopDrill()
 {
-	targetsLeft_ = humanTargets_;
+	schedule_ = std::priority_queue<ScheduledTarget, std::vector<ScheduledTarget>, LaterTarget>();
+	SetUpdateEventMask(0);
 }
\ No newline at end of file
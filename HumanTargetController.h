@@ -1,5 +1,9 @@
 #pragma once
 
+#include <queue>
+#include <vector>
+
+#include <Urho3D/Graphics/Material.h>
 #include <Urho3D/Scene/LogicComponent.h>
 #include <Urho3D/UI/Sprite.h>
 #include <Urho3D/UI/Text.h>
@@ -17,32 +21,46 @@ public:
 
 	static void RegisterObject(Context* context);
 	virtual void Start();
-	virtual void Setup(Vector<Window *> * wh, Sprite * wc, Window * rw, Text * rt);
 
-	void ShowTarget();
-	void SetCanShowTarget(bool toogle);
-	void ResetTargets();
+	/// Build the pop-up schedule of a drill and start it. The same seed always gives the same drill, 0 picks one from the clock.
+	void StartDrill(unsigned seed);
 
-	void EndGame();
+	/// Drop the pop-ups that are still pending.
+	void StopDrill();
 
 	void FixedUpdate(float timeStep);
 
-private:
+	/// Drill settings: targets raised per wave, time between waves and between targets of a wave, random delay added to
+	/// each target, how long a target stays up in the first wave and how much shorter it gets every next wave.
+	unsigned waveSize_ = 2;
+	float waveInterval_ = 3.5f;
+	float waveStagger_ = .4f;
+	float waveJitter_ = .3f;
+	float upTime_ = 3.0f;
+	float upTimeDecay_ = .15f;
+	float minUpTime_ = 1.5f;
+	unsigned victims_ = 2;
 
-	Window * resultWindow_;
+private:
 
-	Text * resultText_;
+	struct ScheduledTarget
+	{
+		float time_;
+		unsigned target_;
+		float upTime_;
+		bool victim_;
+	};
 
-	Vector<Window *> * wh_;
+	struct LaterTarget
+	{
+		bool operator()(const ScheduledTarget& a, const ScheduledTarget& b) const { return a.time_ > b.time_; }
+	};
 
-	Sprite * weaponCrosshair_;
+	void ShowTarget(const ScheduledTarget& entry);
 
-	Vector<Target*> targetsLeft_;
-	unsigned int innocentTargets_;
+	/// Pending pop-ups, the earliest on top.
+	std::priority_queue<ScheduledTarget, std::vector<ScheduledTarget>, LaterTarget> schedule_;
+	float drillTime_ = .0f;
 
-	int targetToMove = -1;
-	float heightToMove;
-	bool canShowTarget = true;
-	bool moveDirection = true;
-	bool firstTarget_ = true;
+	Vector<SharedPtr<Material> > normalMaterials_;
 };
\ No newline at end of file
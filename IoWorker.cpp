@@ -0,0 +1,301 @@
+#include <cstdio>
+#include <cstring>
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/IOEvents.h>
+#include <Urho3D/IO/Log.h>
+
+#include "IoWorker.h"
+#include "Global.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/// Replace dest by source in one step, so a crash leaves either the old or the new file.
+static bool ReplaceFile(const String& source, const String& dest)
+{
+#ifdef _WIN32
+	return MoveFileExW(WString(GetNativePath(source)).CString(), WString(GetNativePath(dest)).CString(),
+		MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	return rename(GetNativePath(source).CString(), GetNativePath(dest).CString()) == 0;
+#endif
+}
+
+static bool WriteData(FILE* file, const IoRequest& request)
+{
+	if (!file)
+		return false;
+
+	bool success = true;
+	if (request.type_ == IO_WRITE_AT)
+		success = fseek(file, request.offset_, SEEK_SET) == 0;
+	if (success && request.data_.Size())
+		success = fwrite(&request.data_[0], request.data_.Size(), 1, file) == 1;
+	success = fflush(file) == 0 && success;
+	fclose(file);
+
+	return success;
+}
+
+IoWorker::IoWorker(Context* context) :
+	Object(context)
+{
+	SubscribeToEvent(E_UPDATE, URHO3D_HANDLER(IoWorker, HandleUpdate));
+	Run();
+}
+
+IoWorker::~IoWorker()
+{
+	Shutdown();
+}
+
+void IoWorker::Shutdown()
+{
+	if (!IsStarted())
+		return;
+
+	Flush();
+	UnsubscribeFromAllEvents();
+
+	// keep waking the thread until it has seen the stop request
+	shouldRun_ = false;
+	while (IsStarted() && !exited_)
+	{
+		requestsReady_.Set();
+		Time::Sleep(1);
+	}
+
+	Stop();
+}
+
+void IoWorker::Post(IoRequestType type, const String& fileName, const void * data, unsigned size, unsigned offset,
+	IoCallback callback, void * owner)
+{
+	// keep the log in order with the requests posted after it
+	PostLog();
+
+	while (waiting_.Size() >= maxWaiting_ && IsStarted())
+	{
+		Pump();
+		requestsReady_.Set();
+		Time::Sleep(1);
+	}
+
+	waiting_.Push(CreateRequest(type, fileName, data, size, offset, callback, owner));
+	Pump();
+}
+
+void IoWorker::SetLogFile(const String& fileName)
+{
+	logFile_ = fileName;
+	Post(IO_WRITE, logFile_);
+
+	SubscribeToEvent(E_LOGMESSAGE, URHO3D_HANDLER(IoWorker, HandleLogMessage));
+}
+
+void IoWorker::Flush()
+{
+	PostLog();
+
+	// besides a full waiting list, the only place the main thread waits for the disk.
+	// callbacks may post more requests, so only stop once a pump leaves nothing behind
+	for (;;)
+	{
+		Pump();
+		if (IsIdle())
+			break;
+
+		requestsReady_.Set();
+		Time::Sleep(1);
+	}
+}
+
+void IoWorker::ThreadFunction()
+{
+	while (shouldRun_)
+	{
+		IoRequest * request = 0;
+
+		mutex_.Acquire();
+		if (queue_.Size())
+		{
+			request = queue_.Front();
+			queue_.Erase(0);
+			busy_ = true;
+		}
+		mutex_.Release();
+
+		if (!request)
+		{
+			// a missed wake up costs at most one frame, the main thread signals again on every update
+			requestsReady_.Wait();
+			continue;
+		}
+
+		request->success_ = Execute(*request);
+
+		mutex_.Acquire();
+		completed_.Push(request);
+		busy_ = false;
+		mutex_.Release();
+	}
+
+	exited_ = true;
+}
+
+bool IoWorker::Execute(IoRequest& request)
+{
+	String nativeName = GetNativePath(request.fileName_);
+
+	switch (request.type_)
+	{
+	case IO_WRITE:
+		return WriteData(fopen(nativeName.CString(), "wb"), request);
+
+	case IO_APPEND:
+		return WriteData(fopen(nativeName.CString(), "ab"), request);
+
+	case IO_WRITE_AT:
+		return WriteData(fopen(nativeName.CString(), "r+b"), request);
+
+	case IO_REPLACE:
+	{
+		String tempName = request.fileName_ + ".tmp";
+		return WriteData(fopen(GetNativePath(tempName).CString(), "wb"), request) && ReplaceFile(tempName, request.fileName_);
+	}
+
+	case IO_DELETE:
+		return remove(nativeName.CString()) == 0;
+	}
+
+	return false;
+}
+
+void IoWorker::HandleLogMessage(StringHash eventType, VariantMap& eventData)
+{
+	using namespace LogMessage;
+
+	const char* prefix = "";
+	switch (eventData[P_LEVEL].GetInt())
+	{
+	case LOG_DEBUG: prefix = "DEBUG"; break;
+	case LOG_INFO: prefix = "INFO"; break;
+	case LOG_WARNING: prefix = "WARNING"; break;
+	case LOG_ERROR: prefix = "ERROR"; break;
+	}
+
+	// past the budget the disk cannot keep up, drop the message and tell later
+	if (logText_.Length() + logBytesPosted_ > maxLogBytes_)
+	{
+		droppedLogMessages_++;
+		return;
+	}
+
+	if (droppedLogMessages_)
+	{
+		logText_ += "[" + Time::GetTimeStamp() + "] WARNING: " + String(droppedLogMessages_) + " log messages dropped, the disk is too slow\n";
+		droppedLogMessages_ = 0;
+	}
+
+	logText_ += "[" + Time::GetTimeStamp() + "] " + prefix + ": " + eventData[P_MESSAGE].GetString() + "\n";
+}
+
+void IoWorker::HandleUpdate(StringHash eventType, VariantMap& eventData)
+{
+	PostLog();
+	Pump();
+
+	if (!IsIdle())
+		requestsReady_.Set();
+}
+
+void IoWorker::Pump()
+{
+	mutex_.Acquire();
+
+	unsigned moved = 0;
+	while (moved < waiting_.Size() && queue_.Size() < capacity_)
+		queue_.Push(waiting_[moved++]);
+
+	// take the finished requests out before any callback runs, a callback may post and pump again
+	PODVector<IoRequest *> finished;
+	finished.Swap(completed_);
+	mutex_.Release();
+
+	if (moved)
+	{
+		waiting_.Erase(0, moved);
+		requestsReady_.Set();
+	}
+
+	for (unsigned int i = 0; i < finished.Size(); i++)
+	{
+		IoRequest * request = finished[i];
+		bool isLog = !logFile_.Empty() && request->type_ == IO_APPEND && request->fileName_ == logFile_;
+		if (isLog)
+			logBytesPosted_ -= request->data_.Size();
+
+		// a failing log file would only log its own failure again
+		if (!request->success_ && !isLog)
+			log_->Write(LOG_ERROR, "Could not write " + request->fileName_);
+		if (request->callback_)
+			request->callback_(request->owner_, request->success_);
+
+		delete request;
+	}
+}
+
+void IoWorker::PostLog()
+{
+	if (logText_.Empty() || logFile_.Empty())
+		return;
+
+	logBytesPosted_ += logText_.Length();
+
+	// join the log request that is still waiting, if it is the last one
+	IoRequest * last = waiting_.Size() ? waiting_.Back() : 0;
+	if (last && last->type_ == IO_APPEND && last->fileName_ == logFile_)
+	{
+		unsigned size = last->data_.Size();
+		last->data_.Resize(size + logText_.Length());
+		memcpy(&last->data_[size], logText_.CString(), logText_.Length());
+	}
+	else if (waiting_.Size() < maxWaiting_)
+		waiting_.Push(CreateRequest(IO_APPEND, logFile_, logText_.CString(), logText_.Length(), 0, 0, 0));
+	else
+	{
+		// no room, keep collecting until there is
+		logBytesPosted_ -= logText_.Length();
+		return;
+	}
+
+	logText_.Clear();
+}
+
+IoRequest * IoWorker::CreateRequest(IoRequestType type, const String& fileName, const void * data, unsigned size,
+	unsigned offset, IoCallback callback, void * owner)
+{
+	IoRequest * request = new IoRequest();
+	request->type_ = type;
+	request->fileName_ = fileName;
+	request->offset_ = offset;
+	request->data_.Resize(size);
+	if (size)
+		memcpy(&request->data_[0], data, size);
+	request->callback_ = callback;
+	request->owner_ = owner;
+	request->success_ = false;
+
+	return request;
+}
+
+bool IoWorker::IsIdle()
+{
+	MutexLock lock(mutex_);
+	return waiting_.Empty() && queue_.Empty() && completed_.Empty() && !busy_;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Urho3D/Core/Condition.h>
+#include <Urho3D/Core/Mutex.h>
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Core/Thread.h>
+
+using namespace Urho3D;
+
+enum IoRequestType
+{
+	/// Create or truncate the file and write the data.
+	IO_WRITE = 0,
+	/// Write the data at the end of the file, creating it if needed.
+	IO_APPEND,
+	/// Write the data at an offset of an existing file.
+	IO_WRITE_AT,
+	/// Write the data to a temporary file and rename it over the file, so a crash leaves the old or the new file.
+	IO_REPLACE,
+	IO_DELETE
+};
+
+/// Called on the main thread when a request is done.
+typedef void (*IoCallback)(void * owner, bool success);
+
+struct IoRequest
+{
+	IoRequestType type_;
+	String fileName_;
+	unsigned offset_;
+	PODVector<unsigned char> data_;
+	IoCallback callback_;
+	void * owner_;
+	bool success_;
+};
+
+/// Thread that does the file writes of the game, so a slow disk never stalls a frame. Requests are done in the order
+/// they are posted. At most capacity_ requests are queued for the thread; more wait on the main thread and move in on
+/// later frames, up to maxWaiting_ of them. Past that limit the disk is hopelessly behind and posting a request blocks
+/// until there is room again, because losing a saved score is worse than a stall.
+/// Log messages are collected during a frame and appended to the log file with one request, which later messages join
+/// while it is still waiting. Log text that is not written yet is limited to maxLogBytes_; messages past that are
+/// dropped and the number dropped is logged once there is room.
+class IoWorker : public Object, public Thread
+{
+	URHO3D_OBJECT(IoWorker, Object);
+
+public:
+	/// Construct and start the thread.
+	IoWorker(Context* context);
+	/// Destruct. Shuts down first.
+	virtual ~IoWorker();
+
+	/// Post a request. The data is copied, the owner has to outlive the request. Callbacks may post again.
+	void Post(IoRequestType type, const String& fileName, const void * data = 0, unsigned size = 0, unsigned offset = 0,
+		IoCallback callback = 0, void * owner = 0);
+	/// Write the log messages to a file instead of letting the log write them on the main thread.
+	void SetLogFile(const String& fileName);
+	/// Block until every posted request is done and its callback has run. Only meant for shutdown.
+	void Flush();
+	/// Flush and join the thread. Nothing can be posted afterwards.
+	void Shutdown();
+
+	/// Most requests queued for the thread.
+	unsigned capacity_ = 64;
+	/// Most requests waiting on the main thread for room in the queue.
+	unsigned maxWaiting_ = 256;
+	/// Most bytes of log text that are not written yet.
+	unsigned maxLogBytes_ = 256 * 1024;
+
+	virtual void ThreadFunction();
+
+private:
+
+	void HandleLogMessage(StringHash eventType, VariantMap& eventData);
+	void HandleUpdate(StringHash eventType, VariantMap& eventData);
+
+	/// Move waiting requests into the queue, post the collected log text and run finished callbacks.
+	void Pump();
+	void PostLog();
+	bool IsIdle();
+	IoRequest * CreateRequest(IoRequestType type, const String& fileName, const void * data, unsigned size, unsigned offset,
+		IoCallback callback, void * owner);
+
+	static bool Execute(IoRequest& request);
+
+	Mutex mutex_;
+	Condition requestsReady_;
+	/// Shared with the thread, guarded by the mutex.
+	PODVector<IoRequest *> queue_;
+	PODVector<IoRequest *> completed_;
+	bool busy_ = false;
+	volatile bool exited_ = false;
+
+	/// Main thread only.
+	PODVector<IoRequest *> waiting_;
+	String logFile_;
+	String logText_;
+	/// Log bytes posted but not written yet.
+	unsigned logBytesPosted_ = 0;
+	unsigned droppedLogMessages_ = 0;
+};
@@ -0,0 +1,157 @@
+#include "Leaderboard.h"
+
+Leaderboard::Leaderboard(bool ascending) :
+	ascending_(ascending)
+{
+}
+
+void Leaderboard::Clear(bool ascending)
+{
+	nodes_.Clear();
+	root_ = NO_NODE;
+	ascending_ = ascending;
+}
+
+unsigned Leaderboard::Insert(float score, unsigned entry)
+{
+	// xorshift keeps the priorities independent of the game's random numbers
+	seed_ ^= seed_ << 13;
+	seed_ ^= seed_ >> 17;
+	seed_ ^= seed_ << 5;
+
+	TreapNode node;
+	node.score_ = score;
+	node.entry_ = entry;
+	node.priority_ = seed_;
+	node.size_ = 1;
+	node.left_ = NO_NODE;
+	node.right_ = NO_NODE;
+	nodes_.Push(node);
+
+	root_ = InsertNode(root_, nodes_.Size() - 1);
+
+	// the new entry is the last of its equals, so everything ranked before it is better or equal
+	unsigned rank = 0;
+	unsigned index = root_;
+	while (nodes_[index].entry_ != entry || nodes_[index].score_ != score)
+	{
+		const TreapNode& current = nodes_[index];
+		if (IsBefore(score, entry, current.score_, current.entry_))
+			index = current.left_;
+		else
+		{
+			rank += GetSubtreeSize(current.left_) + 1;
+			index = current.right_;
+		}
+	}
+
+	return rank + GetSubtreeSize(nodes_[index].left_);
+}
+
+unsigned Leaderboard::GetRank(float score) const
+{
+	unsigned rank = 0;
+	unsigned index = root_;
+	while (index != NO_NODE)
+	{
+		const TreapNode& current = nodes_[index];
+		if (IsBefore(score, NO_NODE, current.score_, current.entry_))
+			index = current.left_;
+		else
+		{
+			rank += GetSubtreeSize(current.left_) + 1;
+			index = current.right_;
+		}
+	}
+
+	return rank;
+}
+
+unsigned Leaderboard::GetEntry(unsigned rank) const
+{
+	unsigned index = root_;
+	while (index != NO_NODE)
+	{
+		const TreapNode& current = nodes_[index];
+		unsigned leftSize = GetSubtreeSize(current.left_);
+
+		if (rank < leftSize)
+			index = current.left_;
+		else if (rank == leftSize)
+			return current.entry_;
+		else
+		{
+			rank -= leftSize + 1;
+			index = current.right_;
+		}
+	}
+
+	return NO_NODE;
+}
+
+void Leaderboard::GetEntries(unsigned firstRank, unsigned count, PODVector<unsigned>& entries) const
+{
+	entries.Clear();
+
+	for (unsigned rank = firstRank; rank < nodes_.Size() && entries.Size() < count; rank++)
+		entries.Push(GetEntry(rank));
+}
+
+bool Leaderboard::IsBefore(float scoreA, unsigned entryA, float scoreB, unsigned entryB) const
+{
+	if (scoreA != scoreB)
+		return ascending_ ? scoreA < scoreB : scoreA > scoreB;
+
+	return entryA < entryB;
+}
+
+unsigned Leaderboard::InsertNode(unsigned root, unsigned index)
+{
+	if (root == NO_NODE)
+		return index;
+
+	TreapNode& node = nodes_[index];
+	if (IsBefore(node.score_, node.entry_, nodes_[root].score_, nodes_[root].entry_))
+	{
+		nodes_[root].left_ = InsertNode(nodes_[root].left_, index);
+		UpdateSize(root);
+		if (nodes_[nodes_[root].left_].priority_ > nodes_[root].priority_)
+			root = RotateRight(root);
+	}
+	else
+	{
+		nodes_[root].right_ = InsertNode(nodes_[root].right_, index);
+		UpdateSize(root);
+		if (nodes_[nodes_[root].right_].priority_ > nodes_[root].priority_)
+			root = RotateLeft(root);
+	}
+
+	return root;
+}
+
+unsigned Leaderboard::RotateLeft(unsigned index)
+{
+	unsigned right = nodes_[index].right_;
+	nodes_[index].right_ = nodes_[right].left_;
+	nodes_[right].left_ = index;
+
+	UpdateSize(index);
+	UpdateSize(right);
+	return right;
+}
+
+unsigned Leaderboard::RotateRight(unsigned index)
+{
+	unsigned left = nodes_[index].left_;
+	nodes_[index].left_ = nodes_[left].right_;
+	nodes_[left].right_ = index;
+
+	UpdateSize(index);
+	UpdateSize(left);
+	return left;
+}
+
+void Leaderboard::UpdateSize(unsigned index)
+{
+	nodes_[index].size_ = 1 + GetSubtreeSize(nodes_[index].left_) + GetSubtreeSize(nodes_[index].right_);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Urho3D/Container/Vector.h>
+
+using namespace Urho3D;
+
+/// Ranked index over the scores of one high score slot. Entries are kept in a treap whose nodes live in one array and
+/// know the size of their subtree, so inserting a score, finding its rank and reading any rank are all O(log n).
+/// Equal scores rank in insertion order.
+class Leaderboard
+{
+public:
+	/// Construct. Ascending boards rank the lowest score first.
+	Leaderboard(bool ascending = false);
+
+	/// Remove all entries and set the order.
+	void Clear(bool ascending);
+	/// Add the score of an entry, usually its journal record index. Returns its rank, 0 is the best.
+	unsigned Insert(float score, unsigned entry);
+
+	/// Rank a new score would get: the number of entries that are better or equal.
+	unsigned GetRank(float score) const;
+	/// Entry at a rank.
+	unsigned GetEntry(unsigned rank) const;
+	/// Entries from a rank on, at most count of them. Pass the rank of a score minus a few to get its neighbors.
+	void GetEntries(unsigned firstRank, unsigned count, PODVector<unsigned>& entries) const;
+
+	unsigned GetSize() const { return nodes_.Size(); }
+	bool IsAscending() const { return ascending_; }
+
+private:
+
+	struct TreapNode
+	{
+		float score_;
+		unsigned entry_;
+		unsigned priority_;
+		unsigned size_;
+		unsigned left_;
+		unsigned right_;
+	};
+
+	/// Whether score a with entry a ranks before score b with entry b.
+	bool IsBefore(float scoreA, unsigned entryA, float scoreB, unsigned entryB) const;
+	unsigned InsertNode(unsigned root, unsigned index);
+	unsigned RotateLeft(unsigned index);
+	unsigned RotateRight(unsigned index);
+	unsigned GetSubtreeSize(unsigned index) const { return index == NO_NODE ? 0 : nodes_[index].size_; }
+	void UpdateSize(unsigned index);
+
+	static const unsigned NO_NODE = 0xffffffff;
+
+	PODVector<TreapNode> nodes_;
+	unsigned root_ = NO_NODE;
+	unsigned seed_ = 0x2545f491;
+	bool ascending_;
+};
@@ -0,0 +1,164 @@
+#include <cstdio>
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Input/Input.h>
+#include <Urho3D/Input/InputEvents.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/UI/Font.h>
+#include <Urho3D/UI/UI.h>
+#include <Urho3D/UI/UIEvents.h>
+
+#include "LeaderboardView.h"
+#include "HighScoreJournal.h"
+#include "Leaderboard.h"
+
+LeaderboardView::LeaderboardView(Context* context) :
+	Object(context)
+{
+}
+
+void LeaderboardView::Create(UIElement * parent, unsigned numRows)
+{
+	ResourceCache* cache = GetSubsystem<ResourceCache>();
+	Font* font = cache->GetResource<Font>("Fonts/Prototype.ttf");
+
+	root_ = parent->CreateChild<UIElement>();
+	root_->SetLayout(LM_HORIZONTAL, 6);
+
+	UIElement * rankColumn = root_->CreateChild<UIElement>();
+	rankColumn->SetLayout(LM_VERTICAL);
+	UIElement * nameColumn = root_->CreateChild<UIElement>();
+	nameColumn->SetLayout(LM_VERTICAL);
+	nameColumn->SetMinWidth(100);
+	UIElement * scoreColumn = root_->CreateChild<UIElement>();
+	scoreColumn->SetLayout(LM_VERTICAL);
+	scoreColumn->SetMinWidth(60);
+
+	for (unsigned int i = 0; i < numRows; i++)
+	{
+		Text * text = rankColumn->CreateChild<Text>();
+		text->SetFont(font, 15);
+		text->SetTextAlignment(HA_RIGHT);
+		rankTexts_.Push(text);
+
+		text = nameColumn->CreateChild<Text>();
+		text->SetFont(font, 15);
+		text->SetTextAlignment(HA_LEFT);
+		nameTexts_.Push(text);
+
+		text = scoreColumn->CreateChild<Text>();
+		text->SetFont(font, 15);
+		text->SetTextAlignment(HA_RIGHT);
+		scoreTexts_.Push(text);
+
+		shownEntries_.Push(NO_ENTRY);
+	}
+
+	scrollBar_ = root_->CreateChild<ScrollBar>();
+	scrollBar_->SetStyleAuto();
+	scrollBar_->SetOrientation(O_VERTICAL);
+	scrollBar_->SetFixedWidth(12);
+	scrollBar_->SetRange(0.0f);
+	scrollBar_->SetScrollStep(1.0f);
+	scrollBar_->SetStepFactor(1.0f);
+
+	SubscribeToEvent(scrollBar_, E_SCROLLBARCHANGED, URHO3D_HANDLER(LeaderboardView, HandleScrollBarChanged));
+	SubscribeToEvent(E_MOUSEWHEEL, URHO3D_HANDLER(LeaderboardView, HandleMouseWheel));
+}
+
+void LeaderboardView::SetSource(const Leaderboard * leaderboard, const HighScoreJournal * journal, bool timeScored)
+{
+	leaderboard_ = leaderboard;
+	journal_ = journal;
+	timeScored_ = timeScored;
+
+	// everything shown so far belongs to another board
+	forceRefresh_ = true;
+}
+
+void LeaderboardView::Refresh()
+{
+	if (!root_)
+		return;
+
+	unsigned size = leaderboard_ ? leaderboard_->GetSize() : 0;
+	unsigned numRows = shownEntries_.Size();
+	unsigned maxFirstRank = size > numRows ? size - numRows : 0;
+
+	if (firstRank_ > maxFirstRank)
+		firstRank_ = maxFirstRank;
+
+	// setting the range may clamp the value, which comes back through the changed event
+	scrollBar_->SetRange((float)maxFirstRank);
+	scrollBar_->SetValue((float)firstRank_);
+
+	if (leaderboard_)
+		leaderboard_->GetEntries(firstRank_, numRows, entries_);
+	else
+		entries_.Clear();
+
+	bool forced = forceRefresh_;
+	bool ranksChanged = forced || firstRank_ != shownFirstRank_;
+	shownFirstRank_ = firstRank_;
+	forceRefresh_ = false;
+
+	const PODVector<HighScoreRecord>* records = journal_ ? &journal_->GetRecords() : 0;
+	char s[20];
+
+	for (unsigned int i = 0; i < numRows; i++)
+	{
+		unsigned entry = i < entries_.Size() ? entries_[i] : NO_ENTRY;
+
+		if (ranksChanged || entry != shownEntries_[i])
+			rankTexts_[i]->SetText(entry != NO_ENTRY ? String(firstRank_ + i + 1) + "." : String::EMPTY);
+
+		if (!forced && entry == shownEntries_[i])
+			continue;
+
+		shownEntries_[i] = entry;
+
+		if (entry == NO_ENTRY)
+		{
+			nameTexts_[i]->SetText(String::EMPTY);
+			scoreTexts_[i]->SetText(String::EMPTY);
+			continue;
+		}
+
+		const HighScoreRecord& record = (*records)[entry];
+		nameTexts_[i]->SetText(record.name_);
+
+		if (timeScored_)
+			sprintf(s, "%0.2fs", record.score_);
+		else
+			sprintf(s, "%d", (int)record.score_);
+		scoreTexts_[i]->SetText(s);
+	}
+}
+
+void LeaderboardView::HandleScrollBarChanged(StringHash eventType, VariantMap& eventData)
+{
+	using namespace ScrollBarChanged;
+
+	unsigned firstRank = (unsigned)(eventData[P_VALUE].GetFloat() + 0.5f);
+	if (firstRank == firstRank_)
+		return;
+
+	firstRank_ = firstRank;
+	Refresh();
+}
+
+void LeaderboardView::HandleMouseWheel(StringHash eventType, VariantMap& eventData)
+{
+	using namespace MouseWheel;
+
+	if (!root_ || !root_->IsVisibleEffective())
+		return;
+
+	// only the list under the cursor scrolls
+	UI* ui = GetSubsystem<UI>();
+	UIElement * hovered = ui->GetElementAt(GetSubsystem<Input>()->GetMousePosition());
+	if (!hovered || (hovered != root_ && !hovered->IsChildOf(root_)))
+		return;
+
+	scrollBar_->ChangeValue(-(float)eventData[P_WHEEL].GetInt() * 3.0f);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/UI/ScrollBar.h>
+#include <Urho3D/UI/Text.h>
+
+using namespace Urho3D;
+
+class HighScoreJournal;
+class Leaderboard;
+
+/// Scrollable list of one leaderboard. The rows are created once and show a window of ranks; refreshing only sets the
+/// texts of rows whose entry or rank changed, so opening or scrolling the list never creates elements, whatever the
+/// number of saved scores.
+class LeaderboardView : public Object
+{
+	URHO3D_OBJECT(LeaderboardView, Object);
+
+public:
+	/// Construct.
+	LeaderboardView(Context* context);
+
+	/// Create the rows and the scroll bar under a parent element.
+	void Create(UIElement * parent, unsigned numRows);
+	/// Set the board to show. Its entries are record indices of the journal.
+	void SetSource(const Leaderboard * leaderboard, const HighScoreJournal * journal, bool timeScored);
+	/// Bring the rows up to date with the board.
+	void Refresh();
+
+private:
+
+	void HandleScrollBarChanged(StringHash eventType, VariantMap& eventData);
+	void HandleMouseWheel(StringHash eventType, VariantMap& eventData);
+
+	static const unsigned NO_ENTRY = 0xffffffff;
+
+	UIElement * root_ = 0;
+	ScrollBar * scrollBar_ = 0;
+	PODVector<Text *> rankTexts_;
+	PODVector<Text *> nameTexts_;
+	PODVector<Text *> scoreTexts_;
+
+	/// What each row shows now, to skip rows that did not change.
+	PODVector<unsigned> shownEntries_;
+	unsigned shownFirstRank_ = NO_ENTRY;
+	unsigned firstRank_ = 0;
+	bool forceRefresh_ = true;
+	PODVector<unsigned> entries_;
+
+	const Leaderboard * leaderboard_ = 0;
+	const HighScoreJournal * journal_ = 0;
+	bool timeScored_ = false;
+};
@@ -0,0 +1,183 @@
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Graphics/BillboardSet.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include "ProjectileSystem.h"
+#include "Weapon.h"
+#include "Global.h"
+
+ProjectileSystem::ProjectileSystem(Context* context) :
+	LogicComponent(context)
+{
+	// Only the physics update event is needed: unsubscribe from the rest for optimization
+	SetUpdateEventMask(USE_FIXEDUPDATE);
+
+	queryMask_ = SHOOTABLE_LAYERS;
+}
+
+void ProjectileSystem::RegisterObject(Context* context)
+{
+	context->RegisterFactory<ProjectileSystem>();
+
+	URHO3D_ATTRIBUTE("Capacity", unsigned, capacity_, 1024, AM_DEFAULT);
+	URHO3D_ATTRIBUTE("Life Time", float, lifeTime_, 2.5f, AM_DEFAULT);
+	URHO3D_ATTRIBUTE("Max Distance", float, maxDistance_, 250.0f, AM_DEFAULT);
+	URHO3D_ATTRIBUTE("Gravity", float, gravity_, 9.81f, AM_DEFAULT);
+	URHO3D_ATTRIBUTE("Query Mask", unsigned, queryMask_, SHOOTABLE_LAYERS, AM_DEFAULT);
+}
+
+void ProjectileSystem::Start()
+{
+	ResourceCache* cache = GetSubsystem<ResourceCache>();
+
+	positions_.Resize(capacity_);
+	velocities_.Resize(capacity_);
+	drags_.Resize(capacity_);
+	distances_.Resize(capacity_);
+	ages_.Resize(capacity_);
+	owners_.Resize(capacity_);
+
+	octree_ = GetScene()->GetComponent<Octree>();
+
+	Node * tracerNode = GetScene()->CreateChild("TracerNode");
+	tracers_ = tracerNode->CreateComponent<BillboardSet>();
+	tracers_->SetNumBillboards(capacity_);
+	tracers_->SetMaterial(cache->GetResource<Material>("Materials/Particle.xml"));
+	tracers_->SetFaceCameraMode(FC_DIRECTION);
+	tracers_->SetRelative(false);
+	tracers_->SetSorted(false);
+	tracers_->SetCastShadows(false);
+	tracers_->SetViewMask(LAYER_EFFECTS);
+
+	for (unsigned int i = 0; i < capacity_; i++)
+	{
+		Billboard * billboard = tracers_->GetBillboard(i);
+		billboard->color_ = Color(1.0f, .85f, .5f);
+		billboard->enabled_ = false;
+	}
+	tracers_->Commit();
+
+	log_->Write(LOG_DEBUG, "Projectile system created, capacity: " + (String)capacity_);
+}
+
+void ProjectileSystem::FixedUpdate(float timeStep)
+{
+	if (!numActive_ && !numTracers_)
+		return;
+
+	Vector3 gravity = Vector3::DOWN * gravity_;
+
+	unsigned int i = 0;
+	while (i < numActive_)
+	{
+		Vector3& velocity = velocities_[i];
+		velocity += (gravity - velocity * (drags_[i] * velocity.Length())) * timeStep;
+
+		Vector3 step = velocity * timeStep;
+		float stepLength = step.Length();
+
+		// sweep the segment travelled in this step. Only shootable layers are visited and the octree tests triangles
+		// of a drawable only when its bounding box is hit closer than the best hit found so far
+		if (octree_ && stepLength > M_EPSILON)
+		{
+			RayOctreeQuery query(results_, Ray(positions_[i], step / stepLength), RAY_TRIANGLE, stepLength, DRAWABLE_GEOMETRY, queryMask_);
+			octree_->RaycastSingle(query);
+
+			if (results_.Size() && results_[0].drawable_)
+			{
+				RayQueryResult& result = results_[0];
+				owners_[i]->FindHit(result.position_, result.drawable_, distances_[i] + result.distance_);
+
+				Release(i);
+				continue;
+			}
+		}
+
+		positions_[i] += step;
+		distances_[i] += stepLength;
+		ages_[i] += timeStep;
+
+		if (ages_[i] > lifeTime_ || distances_[i] > maxDistance_)
+		{
+			Release(i);
+			continue;
+		}
+
+		i++;
+	}
+
+	UpdateTracers();
+}
+
+void ProjectileSystem::Fire(Weapon * owner, const Vector3& position, const Vector3& direction, float speed, float drag)
+{
+	if (positions_.Empty())
+		return;
+
+	if (numActive_ == positions_.Size())
+	{
+		unsigned oldest = 0;
+		for (unsigned int i = 1; i < numActive_; i++)
+		{
+			if (ages_[i] > ages_[oldest])
+				oldest = i;
+		}
+
+		Release(oldest);
+		numExhausted_++;
+	}
+
+	unsigned index = numActive_++;
+	positions_[index] = position;
+	velocities_[index] = direction.Normalized() * speed;
+	drags_[index] = drag;
+	distances_[index] = .0f;
+	ages_[index] = .0f;
+	owners_[index] = owner;
+}
+
+void ProjectileSystem::Release(unsigned index)
+{
+	// keep the active rounds packed at the front of the arrays
+	unsigned last = --numActive_;
+	if (index == last)
+		return;
+
+	positions_[index] = positions_[last];
+	velocities_[index] = velocities_[last];
+	drags_[index] = drags_[last];
+	distances_[index] = distances_[last];
+	ages_[index] = ages_[last];
+	owners_[index] = owners_[last];
+}
+
+void ProjectileSystem::UpdateTracers()
+{
+	if (!tracers_)
+		return;
+
+	unsigned int count = 0;
+	for (unsigned int i = 0; i < numActive_; i++)
+	{
+		// rounds start at the camera, do not draw them across the screen
+		if (distances_[i] < tracerMinDistance_)
+			continue;
+
+		Vector3 direction = velocities_[i].Normalized();
+
+		Billboard * billboard = tracers_->GetBillboard(count++);
+		billboard->position_ = positions_[i] - direction * (tracerLength_ * .5f);
+		billboard->direction_ = direction;
+		billboard->size_ = Vector2(tracerWidth_, tracerLength_ * .5f);
+		billboard->enabled_ = true;
+	}
+
+	for (unsigned int i = count; i < numTracers_; i++)
+		tracers_->GetBillboard(i)->enabled_ = false;
+
+	numTracers_ = count;
+	tracers_->Commit();
+}
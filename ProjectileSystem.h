@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Urho3D/Graphics/BillboardSet.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Scene/LogicComponent.h>
+
+using namespace Urho3D;
+
+class Weapon;
+
+/// Simulates every round in flight. Rounds are stored in parallel arrays, advanced each physics step with gravity and drag,
+/// and hit-tested by sweeping the travelled segment through the octree. Tracers of all rounds are drawn by one BillboardSet.
+class ProjectileSystem : public LogicComponent
+{
+	URHO3D_OBJECT(ProjectileSystem, LogicComponent);
+
+public:
+	/// Construct.
+	ProjectileSystem(Context* context);
+
+	static void RegisterObject(Context* context);
+	virtual void Start();
+
+	void FixedUpdate(float timeStep);
+
+	/// Launch a round. When the system is full the oldest round is dropped and the exhaustion counter grows.
+	void Fire(Weapon * owner, const Vector3& position, const Vector3& direction, float speed, float drag);
+
+	unsigned GetNumActive() const { return numActive_; }
+	unsigned GetNumExhausted() const { return numExhausted_; }
+
+	/// Simulation settings. Capacity has to be set before the component is started.
+	unsigned capacity_ = 1024;
+	float lifeTime_ = 2.5f;
+	float maxDistance_ = 250.0f;
+	float gravity_ = 9.81f;
+	unsigned queryMask_;
+	float tracerLength_ = 2.0f;
+	float tracerWidth_ = .02f;
+	float tracerMinDistance_ = 3.0f;
+
+private:
+
+	void Release(unsigned index);
+	void UpdateTracers();
+
+	PODVector<Vector3> positions_;
+	PODVector<Vector3> velocities_;
+	PODVector<float> drags_;
+	PODVector<float> distances_;
+	PODVector<float> ages_;
+	PODVector<Weapon *> owners_;
+
+	unsigned numActive_ = 0;
+	unsigned numExhausted_ = 0;
+	unsigned numTracers_ = 0;
+
+	PODVector<RayQueryResult> results_;
+
+	WeakPtr<Octree> octree_;
+	WeakPtr<BillboardSet> tracers_;
+};
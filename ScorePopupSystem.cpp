@@ -0,0 +1,252 @@
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Graphics/BillboardSet.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/Technique.h>
+#include <Urho3D/Graphics/Texture2D.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/UI/Font.h>
+#include <Urho3D/UI/FontFace.h>
+
+#include "ScorePopupSystem.h"
+#include "Global.h"
+
+/// Same world size per font pixel as Text3D.
+static const float POPUP_TEXT_SCALING = 1.0f / 128.0f;
+
+ScorePopupSystem::ScorePopupSystem(Context* context) :
+	LogicComponent(context)
+{
+	// Popups are only visual, they follow the rendered frame
+	SetUpdateEventMask(USE_UPDATE);
+}
+
+void ScorePopupSystem::RegisterObject(Context* context)
+{
+	context->RegisterFactory<ScorePopupSystem>();
+
+	URHO3D_ATTRIBUTE("Capacity", unsigned, capacity_, 16, AM_DEFAULT);
+	URHO3D_ATTRIBUTE("Life Time", float, lifeTime_, 1.5f, AM_DEFAULT);
+	URHO3D_ATTRIBUTE("Font Size", float, fontSize_, 80.0f, AM_DEFAULT);
+}
+
+void ScorePopupSystem::Start()
+{
+	ResourceCache* cache = GetSubsystem<ResourceCache>();
+
+	positions_.Resize(capacity_);
+	ages_.Resize(capacity_);
+	widths_.Resize(capacity_);
+	lengths_.Resize(capacity_);
+	glyphs_.Resize(capacity_ * MAX_CHARS);
+
+	cameraNode_ = GetScene()->GetChild("CameraNode");
+
+	Font * font = cache->GetResource<Font>(fontName_);
+	FontFace * face = font ? font->GetFace(fontSize_) : 0;
+	if (!face)
+	{
+		log_->Write(LOG_ERROR, "Score popups disabled, could not load font: " + fontName_);
+		return;
+	}
+
+	// rasterize the glyphs once and remember where they are in the face texture
+	const char * chars = "+0123456789";
+	unsigned page = 0;
+	for (unsigned int i = 0; i < NUM_GLYPHS; i++)
+	{
+		const FontGlyph * glyph = face->GetGlyph(chars[i]);
+		if (!glyph)
+		{
+			log_->Write(LOG_ERROR, "Score popups disabled, font has no glyph for: " + String(chars[i]));
+			return;
+		}
+
+		if (i == 0)
+			page = glyph->page_;
+		else if (glyph->page_ != page)
+		{
+			log_->Write(LOG_ERROR, "Score popups disabled, digits are spread over several font textures");
+			return;
+		}
+
+		glyphRects_[i].uv_ = Rect((float)glyph->x_, (float)glyph->y_, (float)(glyph->x_ + glyph->width_), (float)(glyph->y_ + glyph->height_));
+		glyphRects_[i].size_ = Vector2((float)glyph->width_, (float)glyph->height_) * POPUP_TEXT_SCALING;
+		glyphRects_[i].offset_ = Vector2((float)glyph->offsetX_, (float)glyph->offsetY_) * POPUP_TEXT_SCALING;
+		glyphRects_[i].advance_ = (float)glyph->advanceX_ * POPUP_TEXT_SCALING;
+	}
+
+	Texture2D * texture = face->GetTextures()[page];
+	Vector2 textureSize((float)texture->GetWidth(), (float)texture->GetHeight());
+	for (unsigned int i = 0; i < NUM_GLYPHS; i++)
+	{
+		Rect& uv = glyphRects_[i].uv_;
+		uv = Rect(uv.min_ / textureSize, uv.max_ / textureSize);
+	}
+	rowHeight_ = face->GetRowHeight() * POPUP_TEXT_SCALING;
+
+	// the face texture only has alpha, use the same shaders as Text3D
+	SharedPtr<Technique> technique(new Technique(context_));
+	Pass * pass = technique->CreatePass("alpha");
+	pass->SetVertexShader("Text");
+	pass->SetPixelShader("Text");
+	pass->SetPixelShaderDefines("ALPHAMAP");
+	pass->SetBlendMode(BLEND_ALPHA);
+	pass->SetDepthWrite(false);
+
+	SharedPtr<Material> material(new Material(context_));
+	material->SetTechnique(0, technique);
+	material->SetTexture(TU_DIFFUSE, texture);
+
+	// every glyph has a shadow billboard drawn behind it in place of the Text3D stroke
+	unsigned int numBillboards = capacity_ * MAX_CHARS * 2;
+
+	Node * popupNode = GetScene()->CreateChild("ScorePopupNode");
+	billboards_ = popupNode->CreateComponent<BillboardSet>();
+	billboards_->SetNumBillboards(numBillboards);
+	billboards_->SetMaterial(material);
+	billboards_->SetFaceCameraMode(FC_ROTATE_Y);
+	billboards_->SetRelative(false);
+	billboards_->SetSorted(true);
+	billboards_->SetCastShadows(false);
+	billboards_->SetViewMask(LAYER_EFFECTS);
+
+	for (unsigned int i = 0; i < numBillboards; i++)
+		billboards_->GetBillboard(i)->enabled_ = false;
+	billboards_->Commit();
+
+	fontReady_ = true;
+
+	log_->Write(LOG_DEBUG, "Score popups created, capacity: " + (String)capacity_);
+}
+
+void ScorePopupSystem::Update(float timeStep)
+{
+	if (!numActive_ && !numBillboards_)
+		return;
+
+	unsigned int i = 0;
+	while (i < numActive_)
+	{
+		ages_[i] += timeStep;
+
+		if (ages_[i] > lifeTime_)
+		{
+			Release(i);
+			continue;
+		}
+
+		i++;
+	}
+
+	UpdateBillboards();
+}
+
+void ScorePopupSystem::Show(const Vector3& position, int points)
+{
+	if (!fontReady_ || positions_.Empty())
+		return;
+
+	if (numActive_ == positions_.Size())
+	{
+		unsigned oldest = 0;
+		for (unsigned int i = 1; i < numActive_; i++)
+		{
+			if (ages_[i] > ages_[oldest])
+				oldest = i;
+		}
+
+		Release(oldest);
+	}
+
+	String text = "+" + String(points);
+	unsigned length = text.Length() < MAX_CHARS ? text.Length() : MAX_CHARS;
+
+	unsigned index = numActive_++;
+	unsigned char * glyphs = &glyphs_[index * MAX_CHARS];
+	float width = .0f;
+	for (unsigned int i = 0; i < length; i++)
+	{
+		glyphs[i] = text[i] == '+' ? 0 : (unsigned char)(text[i] - '0' + 1);
+		width += glyphRects_[glyphs[i]].advance_;
+	}
+
+	positions_[index] = position;
+	ages_[index] = .0f;
+	widths_[index] = width;
+	lengths_[index] = length;
+}
+
+void ScorePopupSystem::Release(unsigned index)
+{
+	// keep the active popups packed at the front of the arrays
+	unsigned last = --numActive_;
+	if (index == last)
+		return;
+
+	positions_[index] = positions_[last];
+	ages_[index] = ages_[last];
+	widths_[index] = widths_[last];
+	lengths_[index] = lengths_[last];
+	for (unsigned int i = 0; i < MAX_CHARS; i++)
+		glyphs_[index * MAX_CHARS + i] = glyphs_[last * MAX_CHARS + i];
+}
+
+void ScorePopupSystem::UpdateBillboards()
+{
+	if (!billboards_)
+		return;
+
+	// glyphs rotate around their own centers, so the row itself is laid out across the view
+	Vector3 right = Vector3::RIGHT;
+	Vector3 forward = Vector3::FORWARD;
+	if (cameraNode_)
+	{
+		forward = cameraNode_->GetWorldDirection();
+		forward.y_ = .0f;
+		if (forward.LengthSquared() > M_EPSILON)
+		{
+			forward.Normalize();
+			right = Vector3::UP.CrossProduct(forward);
+		}
+	}
+
+	float shadowOffset = fontSize_ * .03f * POPUP_TEXT_SCALING;
+
+	unsigned int count = 0;
+	for (unsigned int i = 0; i < numActive_; i++)
+	{
+		const unsigned char * glyphs = &glyphs_[i * MAX_CHARS];
+		float x = -widths_[i] * .5f;
+
+		for (unsigned int c = 0; c < lengths_[i]; c++)
+		{
+			const GlyphRect& rect = glyphRects_[glyphs[c]];
+
+			Vector3 center = positions_[i] +
+				right * (x + rect.offset_.x_ + rect.size_.x_ * .5f) +
+				Vector3::UP * (rowHeight_ * .5f - rect.offset_.y_ - rect.size_.y_ * .5f);
+			x += rect.advance_;
+
+			Billboard * shadow = billboards_->GetBillboard(count++);
+			shadow->position_ = center + (right - Vector3::UP + forward) * shadowOffset;
+			shadow->size_ = rect.size_ * .5f;
+			shadow->uv_ = rect.uv_;
+			shadow->color_ = shadowColor_;
+			shadow->enabled_ = true;
+
+			Billboard * billboard = billboards_->GetBillboard(count++);
+			billboard->position_ = center;
+			billboard->size_ = rect.size_ * .5f;
+			billboard->uv_ = rect.uv_;
+			billboard->color_ = color_;
+			billboard->enabled_ = true;
+		}
+	}
+
+	for (unsigned int i = count; i < numBillboards_; i++)
+		billboards_->GetBillboard(i)->enabled_ = false;
+
+	numBillboards_ = count;
+	billboards_->Commit();
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Urho3D/Graphics/BillboardSet.h>
+#include <Urho3D/Scene/LogicComponent.h>
+
+using namespace Urho3D;
+
+/// Floating "+points" texts shown where a target was destroyed. Popups live in a fixed pool and every glyph is a billboard
+/// of one BillboardSet that samples the font face texture directly, so all popups are drawn in a single batch and showing
+/// one neither creates nodes nor lays out text.
+class ScorePopupSystem : public LogicComponent
+{
+	URHO3D_OBJECT(ScorePopupSystem, LogicComponent);
+
+public:
+	/// Construct.
+	ScorePopupSystem(Context* context);
+
+	static void RegisterObject(Context* context);
+	virtual void Start();
+
+	void Update(float timeStep);
+
+	/// Show "+points" at a world position. When the pool is full the oldest popup is reused.
+	void Show(const Vector3& position, int points);
+
+	/// Popup settings. Capacity, font and font size have to be set before the component is started.
+	unsigned capacity_ = 16;
+	float lifeTime_ = 1.5f;
+	String fontName_ = "Fonts/BlueHighway.ttf";
+	float fontSize_ = 80.0f;
+	Color color_ = Color::GREEN;
+	Color shadowColor_ = Color::BLACK;
+
+private:
+
+	/// Longest text a popup can show, including the plus sign.
+	static const unsigned MAX_CHARS = 6;
+	/// Glyphs of "+0123456789".
+	static const unsigned NUM_GLYPHS = 11;
+
+	struct GlyphRect
+	{
+		Rect uv_;
+		Vector2 size_;
+		Vector2 offset_;
+		float advance_;
+	};
+
+	void Release(unsigned index);
+	void UpdateBillboards();
+
+	PODVector<Vector3> positions_;
+	PODVector<float> ages_;
+	PODVector<float> widths_;
+	PODVector<unsigned> lengths_;
+	PODVector<unsigned char> glyphs_;
+
+	unsigned numActive_ = 0;
+	unsigned numBillboards_ = 0;
+
+	GlyphRect glyphRects_[NUM_GLYPHS];
+	float rowHeight_ = .0f;
+	bool fontReady_ = false;
+
+	WeakPtr<Node> cameraNode_;
+	WeakPtr<BillboardSet> billboards_;
+};
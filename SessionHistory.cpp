@@ -0,0 +1,411 @@
+#include <cstring>
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Math/MathDefs.h>
+
+#include "SessionHistory.h"
+#include "Global.h"
+
+static const char* columnNames[] =
+{
+	"date",
+	"shooter",
+	"mode",
+	"weapon",
+	"duration",
+	"shots_fired",
+	"shots_hit",
+	"targets_destroyed",
+	"score",
+	"first_shot",
+	"previous",
+	"shot_times"
+};
+
+static unsigned FloatBits(float value)
+{
+	unsigned bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+static float BitsFloat(unsigned bits)
+{
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+SessionHistory::SessionHistory(Context* context) :
+	Object(context)
+{
+	SubscribeToEvent(gameState_, E_GAMESTATECHANGED, URHO3D_HANDLER(SessionHistory, HandleGameStateChanged));
+	SubscribeToEvent(gameState_, E_ROUNDENDED, URHO3D_HANDLER(SessionHistory, HandleRoundEnded));
+}
+
+void SessionHistory::Open(const String& directory)
+{
+	directory_ = AddTrailingSlash(directory);
+
+	FileSystem* fileSystem = GetSubsystem<FileSystem>();
+	fileSystem->CreateDir(directory_);
+
+	// a crash may have written a round to some columns only, the shortest column decides. the back links are left
+	// out, an older history has none and gets them from the index rebuild
+	diskRows_ = M_MAX_UNSIGNED;
+	for (unsigned int i = 0; i <= MAX_SESSION_COLUMNS; i++)
+	{
+		String fileName = GetColumnFileName(i);
+		files_[i].Reset();
+
+		if (!fileSystem->FileExists(fileName))
+		{
+			ioWorker_->Post(IO_WRITE, fileName);
+			if (i < MAX_SESSION_COLUMNS && i != SC_PREVIOUS)
+				diskRows_ = 0;
+			continue;
+		}
+
+		files_[i] = new File(context_, fileName, FILE_READ);
+		if (i < MAX_SESSION_COLUMNS && i != SC_PREVIOUS)
+			diskRows_ = Min(diskRows_, files_[i]->GetSize() / (unsigned)sizeof(unsigned));
+	}
+
+	// shot times are written before their round, so the last round tells how many of them are complete
+	diskShotTimes_ = 0;
+	if (diskRows_ && files_[MAX_SESSION_COLUMNS])
+	{
+		unsigned lastRow = diskRows_ - 1;
+		unsigned shotTimes = ReadValue(SC_FIRST_SHOT, lastRow) + ReadValue(SC_SHOTS_FIRED, lastRow);
+		diskShotTimes_ = Min(shotTimes, files_[MAX_SESSION_COLUMNS]->GetSize() / (unsigned)sizeof(float));
+	}
+	else
+		diskRows_ = 0;
+
+	memoryRows_ = 0;
+	unclaimedRow_ = M_MAX_UNSIGNED;
+	memoryShotTimes_.Clear();
+	for (unsigned int i = 0; i < MAX_SESSION_COLUMNS; i++)
+		memoryColumns_[i].Clear();
+
+	if (!LoadIndex())
+		RebuildIndex();
+
+	log_->Write(LOG_INFO, "Session history opened, rounds: " + String(diskRows_));
+}
+
+bool SessionHistory::ClaimRound(const String& shooter)
+{
+	if (unclaimedRow_ == M_MAX_UNSIGNED || shooter.Empty())
+		return false;
+
+	unsigned hash = StringHash(shooter).Value();
+	unsigned previous = M_MAX_UNSIGNED;
+	HashMap<unsigned, unsigned>::Iterator last = lastRounds_.Find(hash);
+	if (last != lastRounds_.End())
+		previous = last->second_;
+
+	memoryColumns_[SC_SHOOTER][unclaimedRow_ - diskRows_] = hash;
+	memoryColumns_[SC_PREVIOUS][unclaimedRow_ - diskRows_] = previous;
+	ioWorker_->Post(IO_WRITE_AT, GetColumnFileName(SC_SHOOTER), &hash, sizeof(unsigned), unclaimedRow_ * sizeof(unsigned));
+	ioWorker_->Post(IO_WRITE_AT, GetColumnFileName(SC_PREVIOUS), &previous, sizeof(unsigned), unclaimedRow_ * sizeof(unsigned));
+
+	lastRounds_[hash] = unclaimedRow_;
+	WriteIndex(GetNumRows());
+
+	unclaimedRow_ = M_MAX_UNSIGNED;
+	return true;
+}
+
+void SessionHistory::FindRecentSessions(const String& shooter, unsigned count, PODVector<unsigned>& rows, const String& mode)
+{
+	rows.Clear();
+	if (shooter.Empty())
+		return;
+
+	HashMap<unsigned, unsigned>::ConstIterator last = lastRounds_.Find(StringHash(shooter).Value());
+	if (last == lastRounds_.End())
+		return;
+
+	unsigned modeHash = StringHash(mode).Value();
+
+	// follow the back links from the newest round of the shooter, rounds of other shooters are never read
+	unsigned row = last->second_;
+	while (rows.Size() < count)
+	{
+		if (mode.Empty() || ReadValue(SC_MODE, row) == modeHash)
+			rows.Push(row);
+
+		// links only point to older rounds, anything else ends the chain
+		unsigned previous = ReadValue(SC_PREVIOUS, row);
+		if (previous >= row)
+			break;
+
+		row = previous;
+	}
+}
+
+void SessionHistory::GetIntColumn(SessionColumn column, const PODVector<unsigned>& rows, PODVector<int>& values)
+{
+	values.Resize(rows.Size());
+	for (unsigned int i = 0; i < rows.Size(); i++)
+		values[i] = (int)ReadValue(column, rows[i]);
+}
+
+void SessionHistory::GetFloatColumn(SessionColumn column, const PODVector<unsigned>& rows, PODVector<float>& values)
+{
+	values.Resize(rows.Size());
+	for (unsigned int i = 0; i < rows.Size(); i++)
+		values[i] = BitsFloat(ReadValue(column, rows[i]));
+}
+
+void SessionHistory::GetShotTimes(unsigned row, PODVector<float>& times)
+{
+	times.Clear();
+	if (row >= GetNumRows())
+		return;
+
+	unsigned first = ReadValue(SC_FIRST_SHOT, row);
+	unsigned count = ReadValue(SC_SHOTS_FIRED, row);
+	times.Resize(count);
+
+	// the part that was in the file when it was opened, then the part written in this session
+	unsigned onDisk = first < diskShotTimes_ ? Min(count, diskShotTimes_ - first) : 0;
+	if (onDisk)
+	{
+		File * file = files_[MAX_SESSION_COLUMNS];
+		file->Seek(first * sizeof(float));
+		file->Read(&times[0], onDisk * sizeof(float));
+	}
+
+	for (unsigned int i = onDisk; i < count; i++)
+	{
+		// a torn write may have left fewer shot times than the row claims
+		unsigned index = first + i - diskShotTimes_;
+		if (first + i < diskShotTimes_ || index >= memoryShotTimes_.Size())
+		{
+			times.Resize(i);
+			break;
+		}
+
+		times[i] = memoryShotTimes_[index];
+	}
+}
+
+void SessionHistory::GetAccuracyTrend(const String& shooter, unsigned count, PODVector<float>& accuracies)
+{
+	PODVector<unsigned> rows;
+	PODVector<int> fired;
+	PODVector<int> hit;
+
+	FindRecentSessions(shooter, count, rows);
+	GetIntColumn(SC_SHOTS_FIRED, rows, fired);
+	GetIntColumn(SC_SHOTS_HIT, rows, hit);
+
+	accuracies.Resize(rows.Size());
+	for (unsigned int i = 0; i < rows.Size(); i++)
+		accuracies[i] = fired[i] > 0 ? (float)hit[i] / (float)fired[i] : 0.0f;
+}
+
+float SessionHistory::GetAccuracy(const String& shooter, unsigned count)
+{
+	PODVector<unsigned> rows;
+	PODVector<int> fired;
+	PODVector<int> hit;
+
+	FindRecentSessions(shooter, count, rows);
+	GetIntColumn(SC_SHOTS_FIRED, rows, fired);
+	GetIntColumn(SC_SHOTS_HIT, rows, hit);
+
+	int totalFired = 0;
+	int totalHit = 0;
+	for (unsigned int i = 0; i < rows.Size(); i++)
+	{
+		totalFired += fired[i];
+		totalHit += hit[i];
+	}
+
+	return totalFired > 0 ? (float)totalHit / (float)totalFired : 0.0f;
+}
+
+void SessionHistory::HandleGameStateChanged(StringHash eventType, VariantMap& eventData)
+{
+	using namespace GameStateChanged;
+
+	int field = eventData[P_FIELD].GetInt();
+
+	if (field == GS_GAME_MODE && gameState_->GetGameMode())
+	{
+		lastShotsFired_ = gameState_->GetCounter(GS_SHOTS_FIRED);
+		shotTimes_.Clear();
+	}
+	else if (field == GS_SHOTS_FIRED && gameState_->GetGameMode())
+	{
+		// one time per round fired, a shot that fires several rounds gives them the same time
+		float time = gameState_->GetRoundTime();
+		for (int shots = gameState_->GetCounter(GS_SHOTS_FIRED); lastShotsFired_ < shots; lastShotsFired_++)
+			shotTimes_.Push(time);
+	}
+	else if (field == GS_SHOTS_FIRED)
+		lastShotsFired_ = gameState_->GetCounter(GS_SHOTS_FIRED);
+}
+
+void SessionHistory::HandleRoundEnded(StringHash eventType, VariantMap& eventData)
+{
+	using namespace RoundEnded;
+
+	GameMode * mode = (GameMode *)eventData[P_MODE].GetPtr();
+	if (!mode || directory_.Empty())
+		return;
+
+	unsigned row[MAX_SESSION_COLUMNS];
+	row[SC_DATE] = Time::GetTimeSinceEpoch();
+	row[SC_SHOOTER] = 0;
+	row[SC_MODE] = StringHash(mode->GetId()).Value();
+	row[SC_WEAPON] = (unsigned)gameState_->GetSelectedWeapon();
+	row[SC_DURATION] = FloatBits(gameState_->GetRoundTime());
+	row[SC_SHOTS_FIRED] = shotTimes_.Size();
+	row[SC_SHOTS_HIT] = (unsigned)gameState_->GetCounter(GS_SHOTS_HIT);
+	row[SC_TARGETS_DESTROYED] = (unsigned)gameState_->GetCounter(GS_TARGETS_DESTROYED);
+	row[SC_SCORE] = FloatBits(gameState_->GetFinalScore());
+	row[SC_FIRST_SHOT] = diskShotTimes_ + memoryShotTimes_.Size();
+	row[SC_PREVIOUS] = M_MAX_UNSIGNED;
+
+	Append(row);
+}
+
+void SessionHistory::Append(const unsigned * row)
+{
+	// shot times go first, a round is only counted once every column has it
+	unsigned firstShot = row[SC_FIRST_SHOT];
+	if (shotTimes_.Size())
+	{
+		ioWorker_->Post(IO_WRITE_AT, GetColumnFileName(MAX_SESSION_COLUMNS), &shotTimes_[0], shotTimes_.Size() * sizeof(float),
+			firstShot * sizeof(float));
+		memoryShotTimes_.Push(shotTimes_);
+	}
+
+	unsigned index = diskRows_ + memoryRows_;
+	for (unsigned int i = 0; i < MAX_SESSION_COLUMNS; i++)
+	{
+		ioWorker_->Post(IO_WRITE_AT, GetColumnFileName(i), &row[i], sizeof(unsigned), index * sizeof(unsigned));
+		memoryColumns_[i].Push(row[i]);
+	}
+
+	// an older round that was never claimed stays without a shooter
+	unclaimedRow_ = index;
+	memoryRows_++;
+	shotTimes_.Clear();
+
+	WriteIndex(GetNumRows());
+}
+
+unsigned SessionHistory::ReadValue(SessionColumn column, unsigned row)
+{
+	if (row >= diskRows_)
+		return memoryColumns_[column][row - diskRows_];
+
+	File * file = files_[column];
+	file->Seek(row * sizeof(unsigned));
+	return file->ReadUInt();
+}
+
+String SessionHistory::GetColumnFileName(unsigned column) const
+{
+	return directory_ + columnNames[column] + ".col";
+}
+
+bool SessionHistory::LoadIndex()
+{
+	lastRounds_.Clear();
+	if (!diskRows_)
+		return true;
+
+	// an older history has no back links
+	if (!files_[SC_PREVIOUS] || files_[SC_PREVIOUS]->GetSize() / sizeof(unsigned) < diskRows_)
+		return false;
+
+	String fileName = directory_ + "shooters.idx";
+	if (!GetSubsystem<FileSystem>()->FileExists(fileName))
+		return false;
+
+	// the index is replaced after the rounds it covers are written, a crash in between leaves it out of step
+	File file(context_, fileName, FILE_READ);
+	if (file.GetSize() < 2 * sizeof(unsigned) || file.ReadUInt() != diskRows_)
+		return false;
+
+	unsigned numShooters = file.ReadUInt();
+	if (file.GetSize() < (2 + numShooters * 2) * sizeof(unsigned))
+		return false;
+
+	for (unsigned int i = 0; i < numShooters; i++)
+	{
+		unsigned hash = file.ReadUInt();
+		unsigned row = file.ReadUInt();
+		if (row >= diskRows_)
+			return false;
+
+		lastRounds_[hash] = row;
+	}
+
+	return true;
+}
+
+void SessionHistory::RebuildIndex()
+{
+	log_->Write(LOG_INFO, "Rebuilding the shooter index of the session history");
+
+	lastRounds_.Clear();
+	PODVector<unsigned> previous(diskRows_);
+
+	File * shooterFile = files_[SC_SHOOTER];
+	shooterFile->Seek(0);
+	for (unsigned start = 0; start < diskRows_; start += SCAN_CHUNK)
+	{
+		chunk_.Resize(Min((unsigned)SCAN_CHUNK, diskRows_ - start));
+		shooterFile->Read(&chunk_[0], chunk_.Size() * sizeof(unsigned));
+
+		for (unsigned int i = 0; i < chunk_.Size(); i++)
+		{
+			previous[start + i] = M_MAX_UNSIGNED;
+			if (!chunk_[i])
+				continue;
+
+			HashMap<unsigned, unsigned>::Iterator last = lastRounds_.Find(chunk_[i]);
+			if (last != lastRounds_.End())
+			{
+				previous[start + i] = last->second_;
+				last->second_ = start + i;
+			}
+			else
+				lastRounds_[chunk_[i]] = start + i;
+		}
+	}
+
+	// the file must not be open while it is replaced, and queries read it back, so wait for it once here at startup
+	String fileName = GetColumnFileName(SC_PREVIOUS);
+	files_[SC_PREVIOUS].Reset();
+	ioWorker_->Post(IO_REPLACE, fileName, &previous[0], diskRows_ * sizeof(unsigned));
+	WriteIndex(diskRows_);
+	ioWorker_->Flush();
+
+	files_[SC_PREVIOUS] = new File(context_, fileName, FILE_READ);
+}
+
+void SessionHistory::WriteIndex(unsigned rows)
+{
+	VectorBuffer buffer;
+	buffer.WriteUInt(rows);
+	buffer.WriteUInt(lastRounds_.Size());
+	for (HashMap<unsigned, unsigned>::ConstIterator i = lastRounds_.Begin(); i != lastRounds_.End(); ++i)
+	{
+		buffer.WriteUInt(i->first_);
+		buffer.WriteUInt(i->second_);
+	}
+
+	ioWorker_->Post(IO_REPLACE, directory_ + "shooters.idx", buffer.GetData(), buffer.GetSize());
+}
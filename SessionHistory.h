@@ -0,0 +1,100 @@
+#pragma once
+
+#include <Urho3D/Container/HashMap.h>
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/IO/File.h>
+
+using namespace Urho3D;
+
+/// Columns of the session history. Every column stores one 4 byte value per round in its own file.
+enum SessionColumn
+{
+	SC_DATE = 0,		// unsigned, seconds since the epoch at the end of the round
+	SC_SHOOTER,			// unsigned, hash of the shooter name, 0 until the round is claimed
+	SC_MODE,			// unsigned, hash of the game mode id
+	SC_WEAPON,			// int, selected weapon
+	SC_DURATION,		// float, seconds
+	SC_SHOTS_FIRED,		// int
+	SC_SHOTS_HIT,		// int
+	SC_TARGETS_DESTROYED,	// int
+	SC_SCORE,			// float, final score
+	SC_FIRST_SHOT,		// unsigned, index of the first shot time of the round in the shot times file
+	SC_PREVIOUS,		// unsigned, row of the previous round of the same shooter, M_MAX_UNSIGNED for none
+	MAX_SESSION_COLUMNS
+};
+
+/// Every finished round, kept as an append-only column store so a query only reads the columns it needs. Every claimed
+/// round links back to the previous round of its shooter, and a small index file keeps the newest round of each
+/// shooter, so asking for the last N rounds of a shooter only reads rounds of that shooter, however long the history
+/// is. Rounds of the running session are also kept in memory, because their writes may still be queued on the I/O
+/// worker.
+/// The shooter of a round is only known when a name is saved on the result screen, so a round is recorded without a
+/// shooter and the name and back link are written into its row when the round is claimed.
+class SessionHistory : public Object
+{
+	URHO3D_OBJECT(SessionHistory, Object);
+
+public:
+	/// Construct. Records every round that ends from now on.
+	SessionHistory(Context* context);
+
+	/// Open the column files in a directory, creating the missing ones.
+	void Open(const String& directory);
+
+	/// Give the last recorded round to a shooter. Fails when it was claimed already or a newer round has ended.
+	bool ClaimRound(const String& shooter);
+
+	/// Rows of the newest rounds of a shooter, newest first. An empty mode id matches every mode.
+	void FindRecentSessions(const String& shooter, unsigned count, PODVector<unsigned>& rows, const String& mode = String::EMPTY);
+	/// Values of an int or unsigned column at the given rows.
+	void GetIntColumn(SessionColumn column, const PODVector<unsigned>& rows, PODVector<int>& values);
+	/// Values of a float column at the given rows.
+	void GetFloatColumn(SessionColumn column, const PODVector<unsigned>& rows, PODVector<float>& values);
+	/// Seconds from the start of a round to each of its shots.
+	void GetShotTimes(unsigned row, PODVector<float>& times);
+
+	/// Accuracy of each of the newest rounds of a shooter, newest first.
+	void GetAccuracyTrend(const String& shooter, unsigned count, PODVector<float>& accuracies);
+	/// Hits per shot over the newest rounds of a shooter, 0 without shots.
+	float GetAccuracy(const String& shooter, unsigned count);
+
+	unsigned GetNumRows() const { return diskRows_ + memoryRows_; }
+
+private:
+
+	void HandleGameStateChanged(StringHash eventType, VariantMap& eventData);
+	void HandleRoundEnded(StringHash eventType, VariantMap& eventData);
+
+	void Append(const unsigned * row);
+	/// Read one raw value of a column.
+	unsigned ReadValue(SessionColumn column, unsigned row);
+	String GetColumnFileName(unsigned column) const;
+
+	/// Read the newest round of each shooter. Fails when the index does not match the rounds on disk.
+	bool LoadIndex();
+	/// Build the back links and the index from the shooter column. Only after a crash or on an older history.
+	void RebuildIndex();
+	/// Replace the index file, rows is the number of rounds it covers.
+	void WriteIndex(unsigned rows);
+
+	/// Rows read at once when rebuilding the index.
+	static const unsigned SCAN_CHUNK = 1024;
+
+	String directory_;
+	/// Complete rounds in the files when they were opened; later rounds are in memory.
+	unsigned diskRows_ = 0;
+	unsigned diskShotTimes_ = 0;
+	unsigned memoryRows_ = 0;
+	/// Row of the last round while it has no shooter.
+	unsigned unclaimedRow_ = M_MAX_UNSIGNED;
+	PODVector<unsigned> memoryColumns_[MAX_SESSION_COLUMNS];
+	PODVector<float> memoryShotTimes_;
+	/// Shooter name hash to the row of the newest round of the shooter.
+	HashMap<unsigned, unsigned> lastRounds_;
+	SharedPtr<File> files_[MAX_SESSION_COLUMNS + 1];
+	PODVector<unsigned> chunk_;
+
+	/// Round being recorded.
+	int lastShotsFired_ = 0;
+	PODVector<float> shotTimes_;
+};
@@ -0,0 +1,39 @@
+#include <Urho3D/Core/Context.h>
+
+#include "Shootable.h"
+
+HashMap<StringHash, ShootableHandler> Shootable::handlers_;
+
+Shootable::Shootable(Context* context) :
+	Component(context)
+{
+}
+
+void Shootable::RegisterObject(Context* context)
+{
+	context->RegisterFactory<Shootable>();
+
+	URHO3D_ACCESSOR_ATTRIBUTE("Kind", GetKind, SetKind, String, String::EMPTY, AM_DEFAULT);
+}
+
+void Shootable::RegisterHandler(const String& kind, ShootableHandler handler)
+{
+	handlers_[StringHash(kind)] = handler;
+}
+
+void Shootable::SetKind(const String& kind)
+{
+	kind_ = kind;
+	kindHash_ = StringHash(kind);
+
+	HashMap<StringHash, ShootableHandler>::ConstIterator i = handlers_.Find(kindHash_);
+	handler_ = i != handlers_.End() ? i->second_ : 0;
+}
+
+bool Shootable::HandleHit(const ShotHit& hit)
+{
+	if (!handler_)
+		return false;
+
+	return handler_(this, hit);
+}
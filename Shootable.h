@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Urho3D/Graphics/Drawable.h>
+#include <Urho3D/Scene/Component.h>
+
+using namespace Urho3D;
+
+class Shootable;
+class Weapon;
+
+struct ShotHit
+{
+	Weapon * shooter_;
+	Drawable * drawable_;
+	Vector3 position_;
+	float distance_;
+};
+
+/// Hit handler for one kind of shootable object. Returns false when the hit was not consumed, the shot then leaves a bullet hole.
+typedef bool (*ShootableHandler)(Shootable * shootable, const ShotHit& hit);
+
+/// Marks a node as interactive for bullets. The kind is resolved to its registered handler once, so a hit dispatches in one call.
+class Shootable : public Component
+{
+	URHO3D_OBJECT(Shootable, Component);
+
+public:
+	/// Construct.
+	Shootable(Context* context);
+
+	static void RegisterObject(Context* context);
+
+	/// Register handler for a kind. Kinds can be set from the scene file through the "Kind" attribute.
+	static void RegisterHandler(const String& kind, ShootableHandler handler);
+
+	void SetKind(const String& kind);
+	const String& GetKind() const { return kind_; }
+	StringHash GetKindHash() const { return kindHash_; }
+
+	bool HandleHit(const ShotHit& hit);
+
+private:
+
+	String kind_;
+	StringHash kindHash_;
+	ShootableHandler handler_ = 0;
+
+	static HashMap<StringHash, ShootableHandler> handlers_;
+};
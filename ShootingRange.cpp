@@ -3,7 +3,9 @@
 #include <vector>
 #include <algorithm>
 
+#include <Urho3D/Audio/Sound.h>
 #include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/ProcessUtils.h>
 #include <Urho3D/Engine/Application.h>
 #include <Urho3D/Input/Input.h>
 #include <Urho3D/Resource/ResourceCache.h>
@@ -37,15 +39,16 @@
 #include <Urho3D/Physics/CollisionShape.h>
 
 #include "ShootingRange.h"
+#include "HitProxy.h"
 
 URHO3D_DEFINE_APPLICATION_MAIN(ShootingRange)
 
 using namespace Urho3D;
 
 Log * log_;
-HashMap<String, VariantMap> weaponsData_;
-VariantMap gameVars_;
-VariantMap gameStats_;
+Vector<WeaponDef> weaponDefs_;
+GameState * gameState_;
+IoWorker * ioWorker_;
 Vector<TargetController*> targetControllers_;
 Vector<Target*> humanTargets_;
 
@@ -57,6 +60,18 @@ ShootingRange::ShootingRange(Context * context) : Application(context)
 	TargetController::RegisterObject(context);
 	HumanTargetController::RegisterObject(context);
 	Destroy::RegisterObject(context);
+	ProjectileSystem::RegisterObject(context);
+	TargetSystem::RegisterObject(context);
+	ScorePopupSystem::RegisterObject(context);
+	TweenSystem::RegisterObject(context);
+	GameModeDriver::RegisterObject(context);
+	SoundPool::RegisterObject(context);
+	DecalManager::RegisterObject(context);
+	ShotLightManager::RegisterObject(context);
+	Shootable::RegisterObject(context);
+
+	RegisterGameModes();
+	RegisterHitHandlers();
 }
 
 void ShootingRange::Setup()
@@ -72,58 +87,24 @@ void ShootingRange::Setup()
 	engineParameters_["MaterialQuality"]	= 4;
 	engineParameters_["TextureQuality"]		= 4;
 
+	// the log file and the high scores are written on the I/O thread
+	ioWorker_ = new IoWorker(context_);
+
 	log_ = new Log(context_);
-	log_->Open("shooting_range_debug.log");
 	log_->SetLevel(LOG_DEBUG);
+	ioWorker_->SetLogFile("shooting_range_debug.log");
 
-	weaponsData_["ak47"]["position"] = Vector3(.2f, -.25f, 0.7f);
-	weaponsData_["ak47"]["scale"] = Vector3(.001f, .001f, .001f);
-	weaponsData_["ak47"]["rotation"] = Quaternion(90, Vector3(0, 0, 1));
-	weaponsData_["ak47"]["model"] = "Models/AK.mdl";
-	weaponsData_["ak47"]["material"] = "Materials/AK.xml";
-	weaponsData_["ak47"]["sound"] = "Sounds/AK.wav";
-	weaponsData_["ak47"]["shootingInterval"] = 0.100f;
-	weaponsData_["ak47"]["maxSpreadTime"] = 1.5f;
-	weaponsData_["ak47"]["spreadFactor"] = 75.0f;
-	weaponsData_["ak47"]["automatic"] = true;
-	weaponsData_["ak47"]["muzzlePosition"] = Vector3(.13f, .02f, .2f);
-	weaponsData_["ak47"]["bulletScale"] = Vector3(.0042f, .0042f, .0042f);
-	weaponsData_["ak47"]["lightRotation"] = Quaternion(.0f, .0f, .0f);
-	weaponsData_["ak47"]["fireRotation"] = Quaternion(-90.0f, .0f, .0f);
-
-	weaponsData_["glock"]["position"] = Vector3(.34f, -.27f, 0.7f);
-	weaponsData_["glock"]["scale"] = Vector3(.0013f, .0013f, .0013f);
-	weaponsData_["glock"]["rotation"] = Quaternion(90, Vector3(0, -1, 0));
-	weaponsData_["glock"]["model"] = "Models/Glock.mdl";
-	weaponsData_["glock"]["material"] = "Materials/Glock.xml";
-	weaponsData_["glock"]["sound"] = "Sounds/Glock.wav";
-	weaponsData_["glock"]["shootingInterval"] = 0.15f;
-	weaponsData_["glock"]["maxSpreadTime"] = 1.5f;
-	weaponsData_["glock"]["spreadFactor"] = 75.0f;
-	weaponsData_["glock"]["automatic"] = false;
-	weaponsData_["glock"]["muzzlePosition"] = Vector3(.16f, .08f, .0f);
-	weaponsData_["glock"]["bulletScale"] = Vector3(.0042f, .0042f, .0042f);
-	weaponsData_["glock"]["lightRotation"] = Quaternion(.0f, 90.0f, .0f);
-	weaponsData_["glock"]["fireRotation"] = Quaternion(.0f, .0f, 90.0f);
-
-	gameVars_["selectedWeapon"] = "ak47";
-	gameVars_["primaryWeapon"] = "ak47";
-	gameVars_["secondaryWeapon"] = "glock";
-	gameVars_["gameMode"] = "none";
-	gameVars_["timeLeft"] = 0.0f;
-	gameVars_["tempPoints"] = 0;
-	gameVars_["lastMode"] = "none";
-
-	gameStats_["shotsFired"] = 0;
-	gameStats_["shotsHit"] = 0;
-	gameStats_["targetsDestroyed"] = 0;
-	gameStats_["targetMissed"] = 0;
-	gameStats_["points"] = 0;
+	gameState_ = new GameState(context_);
 
-	for (unsigned int i = 0; i < 3; i++)
+	// muzzle flash lighting can be lowered for weaker machines: -shotlights off|low|medium|high
+	// the human target drill can be replayed exactly: -drillseed <number>
+	const Vector<String>& arguments = GetArguments();
+	for (unsigned int i = 0; i + 1 < arguments.Size(); i++)
 	{
-		highScoreNames_[i] = new StringVector();
-		highScorePoints_[i] = new VariantVector();
+		if (arguments[i] == "-shotlights")
+			gameState_->shotLightQuality_ = arguments[i + 1].ToLower();
+		else if (arguments[i] == "-drillseed")
+			gameState_->drillSeed_ = ToUInt(arguments[i + 1]);
 	}
 
 	windowHierarchy_ = new Vector<Window *>();
@@ -131,6 +112,13 @@ void ShootingRange::Setup()
 
 void ShootingRange::Start()
 {
+	// load weapon definitions, the game cannot run without at least one weapon
+	if (!LoadWeaponDefs(context_, "Definitions/Weapons.xml"))
+	{
+		ErrorExit("Could not load any weapon from Definitions/Weapons.xml");
+		return;
+	}
+
 	// create static scene content
 	CreateScene();
 
@@ -145,25 +133,45 @@ void ShootingRange::Start()
 	CreateCrosshair();
 	CreateWeapon();
 
+	// score and timer boxes
+	hud_ = new Hud(context_);
+
 	// subscribe to necessary events
 	SubscribeToEvents();
 
-	// read saved high scores.
-	File file(GetContext());
+	// read saved high scores, the old names and points files are converted on first start
 	for (unsigned int i = 0; i < 3; i++)
 	{
-		if (file.Open("Data/Saved/highscore_names_" + (String)i + ".srsf", FILE_READ))
-		{
-			highScoreNames_[i] = new StringVector(file.ReadStringVector());
-			file.Close();
-		}
+		highScores_[i] = new HighScoreJournal(context_);
+		highScores_[i]->Open("Data/Saved/highscores_" + (String)i + ".srj",
+			"Data/Saved/highscore_names_" + (String)i + ".srsf", "Data/Saved/highscore_points_" + (String)i + ".srsf");
+	}
 
-		if (file.Open("Data/Saved/highscore_points_" + (String)i + ".srsf", FILE_READ))
-		{
-			highScorePoints_[i] = new VariantVector(file.ReadVariantVector());
-			file.Close();
-		}
+	// rank them, the time scored drill ranks the lowest time first
+	const HashMap<StringHash, SharedPtr<GameMode> >& modes = GameMode::GetAll();
+	for (HashMap<StringHash, SharedPtr<GameMode> >::ConstIterator i = modes.Begin(); i != modes.End(); ++i)
+	{
+		unsigned slot = i->second_->GetScoreSlot();
+		const PODVector<HighScoreRecord>& records = highScores_[slot]->GetRecords();
+
+		leaderboards_[slot].Clear(i->second_->IsTimeScored());
+		for (unsigned int x = 0; x < records.Size(); x++)
+			leaderboards_[slot].Insert(records[x].score_, x);
+
+		leaderboardViews_[slot]->SetSource(&leaderboards_[slot], highScores_[slot], i->second_->IsTimeScored());
 	}
+
+	// every finished round is recorded
+	sessionHistory_ = new SessionHistory(context_);
+	sessionHistory_->Open("Data/Saved/History");
+}
+
+void ShootingRange::Stop()
+{
+	// scores saved in the last frames must reach the disk before the thread is joined
+	ioWorker_->Shutdown();
+	delete ioWorker_;
+	ioWorker_ = 0;
 }
 
 void ShootingRange::HandleKeyDown(StringHash eventType, VariantMap& eventData)
@@ -220,19 +228,78 @@ void ShootingRange::CreateScene()
 	File loadFile(context_, GetSubsystem<FileSystem>()->GetProgramDir() + "Data/Scenes/test_scene.xml", FILE_READ);
 	scene_->LoadXML(loadFile);
 
-	// get all target controllers
+	// older scenes mark interactive objects with a "tag" variable, give them a Shootable of that kind
 	PODVector<Node *> childs;
+	scene_->GetChildren(childs, true);
+
+	for (unsigned int i = 0; i < childs.Size(); i++)
+	{
+		const Variant& tag = childs[i]->GetVar("tag");
+		if (tag.IsEmpty() || childs[i]->GetComponent<Shootable>())
+			continue;
+
+		Shootable * shootable = childs[i]->CreateComponent<Shootable>();
+		shootable->SetKind(tag.GetString());
+	}
+
+	// sort scene geometry into ray query layers, interactive objects (targets, buttons) can be shot at
+	PODVector<Drawable *> drawables;
+	scene_->GetDerivedComponents<Drawable>(drawables, true);
+
+	for (unsigned int i = 0; i < drawables.Size(); i++)
+	{
+		if (!(drawables[i]->GetDrawableFlags() & DRAWABLE_GEOMETRY))
+			continue;
+
+		if (!drawables[i]->GetNode()->GetComponent<Shootable>())
+			drawables[i]->SetViewMask(LAYER_WORLD);
+		else
+			drawables[i]->SetViewMask(LAYER_TARGETS);
+
+		if (drawables[i]->GetType() == StaticModel::GetTypeStatic())
+			AttachHitProxy(static_cast<StaticModel *>(drawables[i]));
+	}
+
+	// pair the target controllers by their lane name, controllers without one are paired in scene order.
+	// test_scene.xml sets no "Lane" yet, so for now every lane comes from the scene order
 	scene_->GetChildrenWithComponent<TargetController>(childs, true);
 
+	HashMap<String, TargetController *> laneStarts;
+	PODVector<TargetController *> unnamed;
+
 	for (unsigned int i = 0; i < childs.Size(); i++)
 	{
-		if (i % 2 == 1)
+		TargetController * controller = childs[i]->GetComponent<TargetController>();
+		const String& lane = controller->GetLane();
+
+		if (lane.Empty())
 		{
-			targetControllers_.Back()->AddPairedController(childs[i]->GetComponent<TargetController>());
+			unnamed.Push(controller);
 			continue;
 		}
 
-		targetControllers_.Push(childs[i]->GetComponent<TargetController>());
+		HashMap<String, TargetController *>::Iterator start = laneStarts.Find(lane);
+		if (start == laneStarts.End())
+		{
+			laneStarts[lane] = controller;
+			continue;
+		}
+
+		start->second_->AddPairedController(controller);
+		targetControllers_.Push(start->second_);
+		laneStarts.Erase(start);
+	}
+
+	for (HashMap<String, TargetController *>::Iterator i = laneStarts.Begin(); i != laneStarts.End(); ++i)
+		log_->Write(LOG_WARNING, "Lane " + i->first_ + " has only one target controller");
+
+	if (unnamed.Size() % 2 == 1)
+		log_->Write(LOG_WARNING, "Target controller " + unnamed.Back()->GetNode()->GetName() + " has no lane pair");
+
+	for (unsigned int i = 0; i + 1 < unnamed.Size(); i += 2)
+	{
+		unnamed[i]->AddPairedController(unnamed[i + 1]);
+		targetControllers_.Push(unnamed[i]);
 	}
 
 	// get all human targets
@@ -243,15 +310,29 @@ void ShootingRange::CreateScene()
 		childs[i]->Translate(Vector3(1.5f, 0.0f, 0.0f));
 		Node *  node = childs[i]->GetChild("Points");
 		node->SetEnabled(false);
+		node->GetDerivedComponents<Drawable>(drawables, true);
+		for (unsigned int x = 0; x < drawables.Size(); x++)
+			drawables[x]->SetViewMask(LAYER_EFFECTS);
 		humanTargets_.Push(childs[i]->GetComponent<Target>());
 	}
 
+	scene_->CreateComponent<TargetSystem>();
+	scene_->CreateComponent<ScorePopupSystem>();
+	scene_->CreateComponent<TweenSystem>();
+	scene_->CreateComponent<GameModeDriver>();
 	humanTargetController_ = scene_->CreateComponent<HumanTargetController>();
+	scene_->CreateComponent<ProjectileSystem>();
+	scene_->CreateComponent<SoundPool>();
+	scene_->CreateComponent<DecalManager>();
+
+	ShotLightManager * shotLights = scene_->CreateComponent<ShotLightManager>();
+	shotLights->SetQuality(ShotLightManager::GetQualityFromString(gameState_->shotLightQuality_));
 
 	cameraNode_ = scene_->CreateChild("CameraNode");
 	Camera* camera = cameraNode_->CreateComponent<Camera>();
 	camera->SetFarClip(300.0f);
 	camera->SetFov(70.0f);
+	camera->SetViewMask(DEFAULT_VIEWMASK & ~LAYER_HITPROXY);
 
 	Renderer* renderer = GetSubsystem<Renderer>();
 
@@ -287,6 +368,7 @@ void ShootingRange::CreateCharacter()
 	object->SetModel(cache->GetResource<Model>("Models/Mutant/Mutant.mdl"));
 	object->SetMaterial(cache->GetResource<Material>("Models/Mutant/Materials/mutant_M.xml"));
 	object->SetCastShadows(true);
+	object->SetViewMask(LAYER_PLAYER);
 	adjustNode->CreateComponent<AnimationController>();
 
 	// Set the head bone for manual control
@@ -319,39 +401,41 @@ void ShootingRange::CreateWeapon()
 	ResourceCache* cache = GetSubsystem<ResourceCache>();
 
 	Node * weaponNode = cameraNode_->CreateChild("WeaponNode");
-	weaponNode->SetPosition(weaponsData_[gameVars_["selectedWeapon"].GetString()]["position"].GetVector3());
-	weaponNode->SetWorldScale(weaponsData_[gameVars_["selectedWeapon"].GetString()]["scale"].GetVector3());
-	weaponNode->SetRotation(weaponsData_[gameVars_["selectedWeapon"].GetString()]["rotation"].GetQuaternion());
-
-	StaticModel * object = weaponNode->CreateComponent<StaticModel>();
-	object->SetModel(cache->GetResource<Model>(weaponsData_[gameVars_["selectedWeapon"].GetString()]["model"].GetString()));
-	object->SetMaterial(cache->GetResource<Material>(weaponsData_[gameVars_["selectedWeapon"].GetString()]["material"].GetString()));
-	object->SetCastShadows(true);
 
-	Node* lightNode = weaponNode->CreateChild("WeaponShotLightNode");
-	lightNode->SetWorldPosition(weaponNode->GetWorldPosition() + weaponNode->GetWorldRotation() * weaponsData_[gameVars_["selectedWeapon"].GetString()]["muzzlePosition"].GetVector3());
-	lightNode->SetRotation(weaponsData_[gameVars_["selectedWeapon"].GetString()]["lightRotation"].GetQuaternion());
-	lightNode->SetEnabled(false);
-	Light* light = lightNode->CreateComponent<Light>();
-	light->SetLightType(LIGHT_SPOT);
-	light->SetColor(Color(1.0f, .96f, .72f));
-	light->SetRange(50.0f);
-	light->SetFov(270.0f);
-	light->SetCastShadows(true);
-
-	Node * fireNode = weaponNode->CreateChild("WeaponShotFireNode");
-	fireNode->SetWorldPosition(weaponNode->GetWorldPosition() + weaponNode->GetWorldRotation() * weaponsData_[gameVars_["selectedWeapon"].GetString()]["muzzlePosition"].GetVector3());
-	fireNode->SetWorldScale(Vector3(.25f, .25f, .25f));
-	fireNode->SetRotation(weaponsData_[gameVars_["selectedWeapon"].GetString()]["fireRotation"].GetQuaternion());
-	fireNode->SetEnabled(false);
-	object = fireNode->CreateComponent<StaticModel>();
-	object->SetModel(cache->GetResource<Model>("Models/Plane.mdl"));
-	object->SetMaterial(cache->GetResource<Material>("Materials/GunFire.xml"));
-	object->SetCastShadows(false);
+	// build the view model of every weapon up front, switching weapons only toggles these nodes
+	for (unsigned int i = 0; i < weaponDefs_.Size(); i++)
+	{
+		const WeaponDef& def = weaponDefs_[i];
+
+		Node * viewModelNode = weaponNode->CreateChild(def.name_);
+		viewModelNode->SetPosition(def.position_);
+		viewModelNode->SetWorldScale(def.scale_);
+		viewModelNode->SetRotation(def.rotation_);
+
+		StaticModel * object = viewModelNode->CreateComponent<StaticModel>();
+		object->SetModel(cache->GetResource<Model>(def.model_));
+		object->SetMaterial(cache->GetResource<Material>(def.material_));
+		object->SetCastShadows(true);
+		object->SetViewMask(LAYER_PLAYER);
+
+		Node * fireNode = viewModelNode->CreateChild("WeaponShotFireNode");
+		fireNode->SetWorldPosition(viewModelNode->GetWorldPosition() + viewModelNode->GetWorldRotation() * def.muzzlePosition_);
+		fireNode->SetWorldScale(Vector3(.25f, .25f, .25f));
+		fireNode->SetRotation(def.fireRotation_);
+		fireNode->SetEnabled(false);
+		object = fireNode->CreateComponent<StaticModel>();
+		object->SetModel(cache->GetResource<Model>("Models/Plane.mdl"));
+		object->SetMaterial(cache->GetResource<Material>("Materials/GunFire.xml"));
+		object->SetCastShadows(false);
+		object->SetViewMask(LAYER_PLAYER);
+
+		// warm up the shot sound as well
+		cache->GetResource<Sound>(def.sound_);
+
+		viewModelNode->SetEnabled(false);
+	}
 
 	weapon_ = weaponNode->CreateComponent<Weapon>();
-	weapon_->Setup(windowHierarchy_, weaponCrosshair_, resultWindow_, resultText_);
-	humanTargetController_->Setup(windowHierarchy_, weaponCrosshair_, resultWindow_, resultText_);
 }
 
 void ShootingRange::CreateCrosshair()
@@ -490,7 +574,13 @@ void ShootingRange::CreateGUI()
 
 	UIElement * element = statisticsWindow_->CreateChild<UIElement>();
 	element->SetName("content");
-	element->SetLayout(LM_HORIZONTAL);
+	element->SetLayout(LM_HORIZONTAL, 40);
+
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		leaderboardViews_[i] = new LeaderboardView(context_);
+		leaderboardViews_[i]->Create(element, 20);
+	}
 
 	SubscribeToEvent(buttonClose, E_RELEASED, URHO3D_HANDLER(ShootingRange, HandleClosePressed));
 
@@ -544,10 +634,38 @@ void ShootingRange::SubscribeToEvents()
 
 	SubscribeToEvent(E_KEYDOWN, URHO3D_HANDLER(ShootingRange, HandleKeyDown));
 
+	// Show the result screen when a round ends
+	SubscribeToEvent(gameState_, E_GAMESTATECHANGED, URHO3D_HANDLER(ShootingRange, HandleGameStateChanged));
+
 	// Unsubscribe the SceneUpdate event from base class as the camera node is being controlled in HandlePostUpdate() in this sample
 	UnsubscribeFromEvent(E_SCENEUPDATE);
 }
 
+void ShootingRange::HandleGameStateChanged(StringHash eventType, VariantMap& eventData)
+{
+	using namespace GameStateChanged;
+
+	if (eventData[P_FIELD].GetInt() != GS_GAME_MODE || gameState_->GetGameMode())
+		return;
+
+	String text = gameState_->GetResultText();
+
+	// where the score would land if it is saved
+	GameMode * lastMode = gameState_->GetLastMode();
+	float score = lastMode ? GetSavedScore(lastMode) : 0.0f;
+	if (score >= 1.0f)
+	{
+		const Leaderboard& leaderboard = leaderboards_[lastMode->GetScoreSlot()];
+		text += "\n\nYou placed #" + String(leaderboard.GetRank(score) + 1) + " of " + String(leaderboard.GetSize() + 1);
+	}
+
+	resultText_->SetText(text);
+	resultWindow_->SetVisible(true);
+	windowHierarchy_->Push(resultWindow_);
+	GetSubsystem<Input>()->SetMouseVisible(true);
+	weaponCrosshair_->SetVisible(false);
+}
+
 void ShootingRange::HandleUpdate(StringHash eventType, VariantMap& eventData)
 {
 	using namespace Update;
@@ -608,8 +726,6 @@ void ShootingRange::HandleUpdate(StringHash eventType, VariantMap& eventData)
 	{
 		targetControllers_[i]->SpawnTarget();
 	}
-
-	humanTargetController_->ShowTarget();
 }
 
 void ShootingRange::HandlePostUpdate(StringHash eventType, VariantMap& eventData)
@@ -638,7 +754,6 @@ void ShootingRange::HandlePostUpdate(StringHash eventType, VariantMap& eventData
 void ShootingRange::HandleControlClicked(StringHash eventType, VariantMap& eventData)
 {
 	UIElement* clicked = (UIElement*)(eventData[UIMouseClick::P_ELEMENT].GetPtr());
-	ResourceCache* cache = GetSubsystem<ResourceCache>();
 
 	if (!clicked)
 		return;
@@ -646,7 +761,7 @@ void ShootingRange::HandleControlClicked(StringHash eventType, VariantMap& event
 	String name = clicked->GetName();
 	if (name == "exitGame")
 	{
-		log_->Close();
+		ioWorker_->Flush();
 		engine_->Exit();
 	}
 	else if (name == "resume")
@@ -664,118 +779,35 @@ void ShootingRange::HandleControlClicked(StringHash eventType, VariantMap& event
 		windowHierarchy_->Back()->SetVisible(false);
 		windowHierarchy_->Push(statisticsWindow_);
 
-		statisticsWindow_->GetChild("content", false)->RemoveAllChildren();
-
-		using namespace std;
-
+		// the rows are built once, only the ones whose score changed are set again
 		for (unsigned int i = 0; i < 3; i++)
-		{
-			vector<tempstruct> tempvec;
-			vector<tempstruct_f> tempvec_f;
-
-			if (i == 2)
-			{
-				for (unsigned int x = 0; x < highScoreNames_[i]->Size(); x++)
-				{
-					tempstruct_f user;
-					user.name = highScoreNames_[i]->At(x);
-					user.points = highScorePoints_[i]->At(x).GetFloat();
-
-					tempvec_f.push_back(user);
-				}
-
-				sort(tempvec_f.begin(), tempvec_f.end(), compareHighScore_f);
-			}
-			else
-			{
-				for (unsigned int x = 0; x < highScoreNames_[i]->Size(); x++)
-				{
-					tempstruct user;
-					user.name = highScoreNames_[i]->At(x);
-					user.points = highScorePoints_[i]->At(x).GetInt();
-
-					tempvec.push_back(user);
-				}
-
-				sort(tempvec.begin(), tempvec.end(), compareHighScore);
-			}
-
-			UIElement * element = statisticsWindow_->GetChild("content", false)->CreateChild<UIElement>();
-			element->SetLayout(LM_VERTICAL);
-
-			int size = 0;
-			if (i == 2)
-				size = tempvec_f.size();
-			else
-				size = tempvec.size();
-
-			for (int x = 0; x < size && x < 20; x++)
-			{
-				Text * text = element->CreateChild<Text>();
-				if (i == 2)
-					text->SetText((String)tempvec_f.at(x).name);
-				else
-					text->SetText((String)tempvec.at(x).name);
-				text->SetFont(cache->GetResource<Font>("Fonts/Prototype.ttf"), 15);
-				text->SetTextAlignment(HA_LEFT);
-				text->SetAlignment(HA_CENTER, VA_CENTER);
-			}
-
-			element = statisticsWindow_->GetChild("content", false)->CreateChild<UIElement>();
-			element->SetLayout(LM_VERTICAL);
-			element->SetMinWidth(40);
-
-			element = statisticsWindow_->GetChild("content", false)->CreateChild<UIElement>();
-			element->SetLayout(LM_VERTICAL);
-
-			for (int x = 0; x < size && x < 20; x++)
-			{
-				Text * text = element->CreateChild<Text>();
-				if (i == 2)
-				{
-					char s[20];
-					sprintf(s, "%0.2fs", tempvec_f.at(x).points);
-					String str = s;
-
-					text->SetText(str);
-				}
-				else
-					text->SetText((String)tempvec.at(x).points);
-				text->SetFont(cache->GetResource<Font>("Fonts/Prototype.ttf"), 15);
-				text->SetTextAlignment(HA_RIGHT);
-				text->SetAlignment(HA_CENTER, VA_CENTER);
-			}
-
-			if (i != 2)
-			{
-				element = statisticsWindow_->GetChild("content", false)->CreateChild<UIElement>();
-				element->SetLayout(LM_VERTICAL);
-				element->SetMinWidth(40);
-			}
-		}
+			leaderboardViews_[i]->Refresh();
 	}
 	else if (name == "saveResults")
 	{
-		if (gameVars_["tempPoints"].GetInt() < 1)
+		if (gameState_->GetFinalScore() < 1.0f)
 			return;
 
-		int mode = GetModeIntFromString(gameVars_["lastMode"].GetString());
+		GameMode * lastMode = gameState_->GetLastMode();
+		if (!lastMode)
+			return;
+
+		unsigned mode = lastMode->GetScoreSlot();
 
 		String name = resultlineEdit_->GetText();
 		name = name.Substring(0, 9);
 
-		highScoreNames_[mode]->Push(name);
-		highScorePoints_[mode]->Push(gameVars_["tempPoints"]);
-
-		// save files
-		File file(GetContext());
-		file.Open("Data/Saved/highscore_names_" + (String)mode + ".srsf", FILE_WRITE);
-		file.WriteStringVector(*highScoreNames_[mode]);
-		file.Close();
+		// the round was recorded without a shooter, the saved name tells who shot it
+		if (sessionHistory_->ClaimRound(name))
+		{
+			char s[20];
+			sprintf(s, "%0.2f", sessionHistory_->GetAccuracy(name, 10) * 100);
+			log_->Write(LOG_INFO, "Accuracy of " + name + " over the last 10 rounds: " + s + "%");
+		}
 
-		file.Open("Data/Saved/highscore_points_" + (String)mode + ".srsf", FILE_WRITE);
-		file.WriteVariantVector(*highScorePoints_[mode]);
-		file.Close();
+		float score = GetSavedScore(lastMode);
+		highScores_[mode]->Append(name, score);
+		leaderboards_[mode].Insert(score, highScores_[mode]->GetRecords().Size() - 1);
 
 		windowHierarchy_->Back()->SetVisible(false);
 		windowHierarchy_->Pop();
@@ -785,11 +817,12 @@ void ShootingRange::HandleControlClicked(StringHash eventType, VariantMap& event
 	}
 }
 
-int ShootingRange::GetModeIntFromString(String mode)
+float ShootingRange::GetSavedScore(GameMode * mode) const
 {
-	if (mode == "mode_1") return 0;
-	if (mode == "mode_2") return 1;
-	if (mode == "mode_3") return 2;
+	// points modes keep whole points, the time scored drill keeps hundredths of seconds
+	float score = gameState_->GetFinalScore();
+	if (!mode->IsTimeScored())
+		score = (float)(int)score;
 
-	return 0;
-}
\ No newline at end of file
+	return score;
+}
@@ -4,26 +4,30 @@
 #include "Weapon.h"
 #include "Target.h"
 #include "TargetController.h"
+#include "TargetSystem.h"
 #include "HumanTargetController.h"
 #include "Destroy.h"
+#include "ProjectileSystem.h"
+#include "ScorePopupSystem.h"
+#include "TweenSystem.h"
+#include "SoundPool.h"
+#include "DecalManager.h"
+#include "ShotLightManager.h"
+#include "Shootable.h"
+#include "GameModes.h"
+#include "GameModeDriver.h"
+#include "HitHandlers.h"
+#include "Hud.h"
+#include "HighScoreJournal.h"
+#include "Leaderboard.h"
+#include "LeaderboardView.h"
+#include "SessionHistory.h"
 #include "Global.h"
 
 const float CAMERA_MIN_DIST = 1.0f;
 const float CAMERA_INITIAL_DIST = 5.0f;
 const float CAMERA_MAX_DIST = 20.0f;
 
-struct tempstruct
-{
-	String name;
-	int points;
-};
-
-struct tempstruct_f
-{
-	String name;
-	float points;
-};
-
 class ShootingRange : public Application
 {
 public:
@@ -32,6 +36,7 @@ public:
 
 	virtual void Setup();
 	virtual void Start();
+	virtual void Stop();
 
 private:
 
@@ -39,6 +44,7 @@ private:
 	WeakPtr<Weapon> weapon_;
 	SharedPtr<Scene> scene_;
 	SharedPtr<Node> cameraNode_;
+	SharedPtr<Hud> hud_;
 
 	HumanTargetController * humanTargetController_;
 
@@ -56,14 +62,17 @@ private:
 	LineEdit * resultlineEdit_;
 	
 	Vector<Window*> * windowHierarchy_;
-	StringVector * highScoreNames_[3];
-	VariantVector * highScorePoints_[3];
+	SharedPtr<HighScoreJournal> highScores_[3];
+	Leaderboard leaderboards_[3];
+	SharedPtr<LeaderboardView> leaderboardViews_[3];
+	SharedPtr<SessionHistory> sessionHistory_;
 	
 	void HandleKeyDown(StringHash eventType, VariantMap& eventData);
 	void HandleClosePressed(StringHash eventType, VariantMap& eventData);
 	void HandleUpdate(StringHash eventType, VariantMap& eventData);
 	void HandlePostUpdate(StringHash eventType, VariantMap& eventData);
 	void HandleControlClicked(StringHash eventType, VariantMap& eventData);
+	void HandleGameStateChanged(StringHash eventType, VariantMap& eventData);
 
 	void CreateScene();
 	void CreateCharacter();
@@ -73,16 +82,6 @@ private:
 	void CreateGUI();
 	void SubscribeToEvents();
 
-	// util
-	int GetModeIntFromString(String mode);
-};
-
-bool compareHighScore(const tempstruct &a, const tempstruct &b)
-{
-	return a.points > b.points;
-}
-
-bool compareHighScore_f(const tempstruct_f &a, const tempstruct_f &b)
-{
-	return a.points < b.points;
-}
\ No newline at end of file
+	/// Final score of the last round as it is saved for a mode.
+	float GetSavedScore(GameMode * mode) const;
+};
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Graphics/Light.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include "ShotLightManager.h"
+#include "Global.h"
+
+ShotLightManager::ShotLightManager(Context* context) :
+	LogicComponent(context)
+{
+	// Only the physics update event is needed: unsubscribe from the rest for optimization
+	SetUpdateEventMask(USE_FIXEDUPDATE);
+}
+
+void ShotLightManager::RegisterObject(Context* context)
+{
+	context->RegisterFactory<ShotLightManager>();
+
+	URHO3D_ATTRIBUTE("Flash Time", float, flashTime_, .05f, AM_DEFAULT);
+}
+
+void ShotLightManager::Start()
+{
+	unsigned int numLights = 0;
+	float range = 50.0f;
+	bool castShadows = false;
+
+	switch (quality_)
+	{
+	case SHOTLIGHT_OFF:
+		numLights = 0;
+		break;
+	case SHOTLIGHT_LOW:
+		numLights = 1;
+		range = 25.0f;
+		break;
+	case SHOTLIGHT_MEDIUM:
+		numLights = 2;
+		break;
+	case SHOTLIGHT_HIGH:
+		numLights = 4;
+		castShadows = true;
+		break;
+	}
+
+	for (unsigned int i = 0; i < numLights; i++)
+	{
+		Node * lightNode = GetScene()->CreateChild("ShotLightNode");
+		lightNode->SetEnabled(false);
+
+		Light* light = lightNode->CreateComponent<Light>();
+		light->SetLightType(LIGHT_SPOT);
+		light->SetColor(Color(1.0f, .96f, .72f));
+		light->SetRange(range);
+		light->SetFov(270.0f);
+		light->SetCastShadows(castShadows);
+
+		lights_.Push(lightNode);
+		timeLeft_.Push(.0f);
+	}
+
+	log_->Write(LOG_DEBUG, "Shot lights created: " + (String)numLights + " shadows: " + (String)castShadows);
+}
+
+void ShotLightManager::FixedUpdate(float timeStep)
+{
+	for (unsigned int i = 0; i < lights_.Size(); i++)
+	{
+		if (timeLeft_[i] <= .0f)
+			continue;
+
+		timeLeft_[i] -= timeStep;
+		if (timeLeft_[i] <= .0f)
+			lights_[i]->SetEnabled(false);
+	}
+}
+
+void ShotLightManager::Flash(const Vector3& position, const Quaternion& rotation)
+{
+	if (lights_.Empty())
+		return;
+
+	// free light first, otherwise the one closest to going out
+	unsigned index = 0;
+	for (unsigned int i = 1; i < lights_.Size(); i++)
+	{
+		if (timeLeft_[i] < timeLeft_[index])
+			index = i;
+	}
+
+	Node * lightNode = lights_[index];
+	lightNode->SetWorldPosition(position);
+	lightNode->SetWorldRotation(rotation);
+	lightNode->SetEnabled(true);
+
+	timeLeft_[index] = flashTime_;
+}
+
+void ShotLightManager::SetQuality(ShotLightQuality quality)
+{
+	quality_ = quality;
+}
+
+ShotLightQuality ShotLightManager::GetQualityFromString(const String& quality)
+{
+	if (quality == "off") return SHOTLIGHT_OFF;
+	if (quality == "low") return SHOTLIGHT_LOW;
+	if (quality == "medium") return SHOTLIGHT_MEDIUM;
+
+	return SHOTLIGHT_HIGH;
+}
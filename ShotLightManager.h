@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Urho3D/Graphics/Light.h>
+#include <Urho3D/Scene/LogicComponent.h>
+
+using namespace Urho3D;
+
+enum ShotLightQuality
+{
+	SHOTLIGHT_OFF = 0,
+	SHOTLIGHT_LOW,
+	SHOTLIGHT_MEDIUM,
+	SHOTLIGHT_HIGH
+};
+
+/// Shared muzzle flash lights. Every shooter borrows a light from a small budget; when all of them are lit the one
+/// that has been lit the longest is moved to the new shot.
+class ShotLightManager : public LogicComponent
+{
+	URHO3D_OBJECT(ShotLightManager, LogicComponent);
+
+public:
+	/// Construct.
+	ShotLightManager(Context* context);
+
+	static void RegisterObject(Context* context);
+	virtual void Start();
+
+	void FixedUpdate(float timeStep);
+
+	/// Light up a flash at the given world transform.
+	void Flash(const Vector3& position, const Quaternion& rotation);
+
+	/// Pick light budget, range and shadows. Has to be set before the component is started.
+	void SetQuality(ShotLightQuality quality);
+	static ShotLightQuality GetQualityFromString(const String& quality);
+
+	float flashTime_ = .05f;
+
+private:
+
+	ShotLightQuality quality_ = SHOTLIGHT_HIGH;
+
+	PODVector<Node *> lights_;
+	PODVector<float> timeLeft_;
+};
@@ -0,0 +1,123 @@
+#include <Urho3D/Audio/Sound.h>
+#include <Urho3D/Audio/SoundSource.h>
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include "SoundPool.h"
+#include "Global.h"
+
+SoundPool::SoundPool(Context* context) :
+	LogicComponent(context)
+{
+	// Voices are reclaimed when they are requested, no update events are needed
+	SetUpdateEventMask(0);
+
+	categoryLimits_[VOICE_GUNFIRE] = 8;
+	categoryLimits_[VOICE_IMPACT] = 6;
+	categoryLimits_[VOICE_UI] = 2;
+}
+
+void SoundPool::RegisterObject(Context* context)
+{
+	context->RegisterFactory<SoundPool>();
+
+	URHO3D_ATTRIBUTE("Voices", unsigned, numVoices_, 16, AM_DEFAULT);
+}
+
+void SoundPool::Start()
+{
+	Node * soundNode = GetScene()->CreateChild("SoundNode");
+
+	voices_.Resize(numVoices_);
+	categories_.Resize(numVoices_);
+	priorities_.Resize(numVoices_);
+	startOrder_.Resize(numVoices_);
+
+	for (unsigned int i = 0; i < numVoices_; i++)
+	{
+		voices_[i] = soundNode->CreateComponent<SoundSource>();
+		categories_[i] = VOICE_GUNFIRE;
+		priorities_[i] = 0;
+		startOrder_[i] = 0;
+	}
+
+	log_->Write(LOG_DEBUG, "Sound pool created, voices: " + (String)numVoices_);
+}
+
+SoundSource * SoundPool::Play(Sound * sound, VoiceCategory category, float gain, int priority)
+{
+	if (!sound)
+		return 0;
+
+	int index = FindVoice(category, priority);
+	if (index < 0)
+		return 0;
+
+	SoundSource * voice = voices_[index];
+	voice->Stop();
+	voice->SetGain(gain);
+	voice->Play(sound);
+
+	categories_[index] = category;
+	priorities_[index] = priority;
+	startOrder_[index] = ++playCounter_;
+
+	return voice;
+}
+
+void SoundPool::SetCategoryLimit(VoiceCategory category, unsigned limit)
+{
+	categoryLimits_[category] = limit;
+}
+
+unsigned SoundPool::GetNumPlaying(VoiceCategory category) const
+{
+	unsigned count = 0;
+	for (unsigned int i = 0; i < voices_.Size(); i++)
+	{
+		if (categories_[i] == category && voices_[i]->IsPlaying())
+			count++;
+	}
+
+	return count;
+}
+
+int SoundPool::FindVoice(VoiceCategory category, int priority) const
+{
+	int freeVoice = -1;
+	int categoryVictim = -1;
+	int anyVictim = -1;
+	unsigned playing = 0;
+
+	for (unsigned int i = 0; i < voices_.Size(); i++)
+	{
+		if (!voices_[i]->IsPlaying())
+		{
+			if (freeVoice < 0)
+				freeVoice = i;
+			continue;
+		}
+
+		// prefer stealing the lowest priority voice, the oldest one among equals
+		if (anyVictim < 0 || priorities_[i] < priorities_[anyVictim] ||
+			(priorities_[i] == priorities_[anyVictim] && startOrder_[i] < startOrder_[anyVictim]))
+			anyVictim = i;
+
+		if (categories_[i] != category)
+			continue;
+
+		playing++;
+
+		if (categoryVictim < 0 || priorities_[i] < priorities_[categoryVictim] ||
+			(priorities_[i] == priorities_[categoryVictim] && startOrder_[i] < startOrder_[categoryVictim]))
+			categoryVictim = i;
+	}
+
+	if (playing >= categoryLimits_[category])
+		return (categoryVictim >= 0 && priorities_[categoryVictim] <= priority) ? categoryVictim : -1;
+
+	if (freeVoice >= 0)
+		return freeVoice;
+
+	return (anyVictim >= 0 && priorities_[anyVictim] <= priority) ? anyVictim : -1;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Urho3D/Audio/Sound.h>
+#include <Urho3D/Audio/SoundSource.h>
+#include <Urho3D/Scene/LogicComponent.h>
+
+using namespace Urho3D;
+
+enum VoiceCategory
+{
+	VOICE_GUNFIRE = 0,
+	VOICE_IMPACT,
+	VOICE_UI,
+	MAX_VOICE_CATEGORIES
+};
+
+/// Fixed set of reusable SoundSources. A voice is free again as soon as its sound stops playing.
+/// Each category has its own voice limit; when it is reached the lowest priority, oldest voice is stolen.
+class SoundPool : public LogicComponent
+{
+	URHO3D_OBJECT(SoundPool, LogicComponent);
+
+public:
+	/// Construct.
+	SoundPool(Context* context);
+
+	static void RegisterObject(Context* context);
+	virtual void Start();
+
+	/// Play a sound on a pooled voice. Returns null if every candidate voice has a higher priority.
+	SoundSource * Play(Sound * sound, VoiceCategory category, float gain = 1.0f, int priority = 0);
+
+	void SetCategoryLimit(VoiceCategory category, unsigned limit);
+	unsigned GetNumPlaying(VoiceCategory category) const;
+
+	/// Total number of voices. Has to be set before the component is started.
+	unsigned numVoices_ = 16;
+
+private:
+
+	int FindVoice(VoiceCategory category, int priority) const;
+
+	PODVector<SoundSource *> voices_;
+	PODVector<int> categories_;
+	PODVector<int> priorities_;
+	PODVector<unsigned> startOrder_;
+
+	unsigned categoryLimits_[MAX_VOICE_CATEGORIES];
+	unsigned playCounter_ = 0;
+};
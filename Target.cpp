@@ -21,7 +21,6 @@
 #include <Urho3D/Graphics/Skybox.h>
 #include <Urho3D/Graphics/StaticModel.h>
 #include <Urho3D/Graphics/Zone.h>
-#include <Urho3D/UI/Text3D.h>
 #include <Urho3D/Input/Input.h>
 #include <Urho3D/IO/MemoryBuffer.h>
 #include <Urho3D/Physics/CollisionShape.h>
@@ -33,7 +32,7 @@
 #include <Urho3D/UI/Text.h>
 #include <Urho3D/UI/Font.h>
 
-#include "Destroy.h"
+#include "TweenSystem.h"
 #include "Target.h"
 #include "HumanTargetController.h"
 #include "Global.h"
@@ -41,8 +40,8 @@
 Target::Target(Context* context) :
 	LogicComponent(context)
 {
-	// Only the physics update event is needed: unsubscribe from the rest for optimization
-	SetUpdateEventMask(USE_FIXEDUPDATE);
+	// Motion and timers are updated by the target system, no update events are needed
+	SetUpdateEventMask(0);
 }
 
 void Target::RegisterObject(Context* context)
@@ -53,87 +52,70 @@ void Target::RegisterObject(Context* context)
 void Target::Start()
 {
 	log_->Write(LOG_DEBUG, "created target");
-	soundNode_ = GetScene()->CreateChild("SoundNode");
 	cameraNode_ = GetScene()->GetChild("CameraNode");
 	scene_ = GetScene();
 }
 
 void Target::RegisterHit(float amount, float hitDistance)
 {
+	// a human target that is already down keeps being hittable while it retracts, it must not count twice
+	if (ht_isHT_ && !ht_isActive_)
+		return;
+
 	health_ -= amount;
+	bool destroyed = health_ <= 0.0f;
 
-	if (health_ <= 0.0f)
+	// the mode scores the hit before a kill can end the round
+	if (gameState_->GetGameMode())
+		gameState_->GetGameMode()->TargetHit(this, hitDistance, destroyed);
+
+	if (!destroyed)
+		return;
+
+	if (ht_isHT_ == false)
 	{
-		ResourceCache* cache = GetSubsystem<ResourceCache>();
+		log_->Write(LOG_DEBUG, "Target destroyed");
 
-		if (ht_isHT_ == false)
-		{
-			Vector3 pos = GetNode()->GetWorldPosition();
-
-			Node * node = scene_->CreateChild("PointsText");
-			node->SetWorldPosition(pos);
-			Text3D * text = node->CreateComponent<Text3D>();
-			text->SetFont(cache->GetResource<Font>("Fonts/BlueHighway.ttf"), 80);
-			text->SetText("+" + (String)(int)ceil(hitDistance));
-			text->SetColor(Color::GREEN);
-			text->SetTextEffect(TE_STROKE);
-			text->SetFaceCameraMode(FaceCameraMode::FC_ROTATE_Y);
-			Destroy * destroy = node->CreateComponent<Destroy>();
-			destroy->timeAlive_ = 1.5f;
-
-			gameStats_["points"] = gameStats_["points"].GetInt() + (int)ceil(hitDistance);
-
-			GetNode()->SetEnabled(false);
-			destroy = GetNode()->CreateComponent<Destroy>();
-			destroy->timeAlive_ = 2.0f;
-
-			log_->Write(LOG_DEBUG, "Target destroyed");
-
-			if (controller_ && gameVars_["gameMode"].GetString() != "none")
-			{
-				controller_->SetCanCreateTargets(true);
-			}
-		}
-		else if(ht_isActive_ == true)
+		gameState_->AddCounter(GS_TARGETS_DESTROYED);
+		gameState_->AddCounter(GS_TARGETS_LEFT, -1);
+
+		if (controller_)
+			controller_->ReleaseTarget(this);
+
+		if (gameState_->GetGameMode())
+			gameState_->GetGameMode()->TargetRemoved(this);
+	}
+	else
+	{
+		GetSystem()->StopTimer(this, TARGET_TIMER_POPUP);
+
+		gameState_->AddCounter(GS_TARGETS_DESTROYED);
+
+		if (ht_isVictim_ == true)
 		{
-			HumanTargetController * ht_controller = scene_->GetComponent<HumanTargetController>();
-			ht_controller->SetCanShowTarget(true);
-			ht_isActive_ = false;
-
-			GetNode()->Translate(Vector3(1.5f, .0f, .0f));
-
-			if (gameStats_["m3_targetsLeft"].GetInt() == 1)
-			{
-				ht_controller->EndGame();
-			}
-
-			if (ht_isVictim_ == true)
-			{
-				ht_pointsIsActive_ = true;
-				ht_pointsTimeLeft_ = 3.0f;
-				Node * node = GetNode()->GetChild("Points");
-				node->SetEnabled(true);
-				gameVars_["timeLeft"] = gameVars_["timeLeft"].GetFloat() + 10.0f;
-			}
+			GetSystem()->SetTimer(this, TARGET_TIMER_POINTS, 3.0f);
+			Node * node = GetNode()->GetChild("Points");
+			node->SetEnabled(true);
 		}
 
-		Sound* sound = cache->GetResource<Sound>("Sounds/metal.wav");
-
-		SoundSource* soundSource = soundNode_->CreateComponent<SoundSource>();
-		soundSource->Play(sound);
-		soundSource->SetGain(1.0f);
-		
-		gameStats_["targetsDestroyed"] = gameStats_["targetsDestroyed"].GetInt() + 1;
-		gameStats_["m3_targetsLeft"] = gameStats_["m3_targetsLeft"].GetInt() - 1;
+		// hiding may end the round, so the hit has to be counted first and the target left last
+		HT_Hide();
+		gameState_->AddCounter(GS_TARGETS_LEFT, -1);
 	}
 }
 
-void Target::SetMovingTarget(float speed, bool direction)
+void Target::SetPath(const Vector3& start, const Vector3& end, float speed, unsigned bounceLimit)
 {
-	movingDirection_ = direction;
-	movingSpeed_ = speed;
+	// the target reaches a lane end every length / speed seconds, so the despawn time is known up front
+	float length = (end - start).Length();
+	float despawnTime = (bounceLimit && speed > .0f) ? bounceLimit * length / speed : -1.0f;
+
+	GetSystem()->SetPath(this, start, end, speed, despawnTime);
+}
 
-	SubscribeToEvent(GetNode(), E_NODECOLLISIONSTART, URHO3D_HANDLER(Target, HandleNodeCollisionStart));
+void Target::Reset()
+{
+	GetSystem()->Sleep(this);
 }
 
 void Target::SetHealth(float amount)
@@ -146,89 +128,64 @@ void Target::SetController(TargetController * controller)
 	controller_ = controller;
 }
 
-void Target::FixedUpdate(float timeStep)
+void Target::HandlePathEnd()
+{
+	GetNode()->SetWorldPosition(Vector3(1000.0f, 1000.0f, 1000.0f));
+	GetSystem()->SetTimer(this, TARGET_TIMER_RESPAWN, 1.0f);
+}
+
+void Target::HandleTimer(TargetTimer timer)
 {
-	if (ht_isActive_)
+	switch (timer)
 	{
-		if (ht_timeLeft_ > 0.0f)
-		{
-			ht_timeLeft_ -= timeStep;
-		}
-		else
-		{
-			HumanTargetController * ht_controller = scene_->GetComponent<HumanTargetController>();
-			ht_controller->SetCanShowTarget(true);
-			ht_isActive_ = false;
+	case TARGET_TIMER_POPUP:
+		HT_Hide();
+		gameState_->AddCounter(GS_TARGETS_LEFT, -1);
+		break;
 
-			GetNode()->Translate(Vector3(1.5f, .0f, .0f));
+	case TARGET_TIMER_POINTS:
+		GetNode()->GetChild("Points")->SetEnabled(false);
+		break;
 
-			if (gameStats_["m3_targetsLeft"].GetInt() == 1)
-			{
-				ht_controller->EndGame();
-			}
+	case TARGET_TIMER_RESPAWN:
+		if (controller_)
+			controller_->ReleaseTarget(this);
 
-			gameStats_["m3_targetsLeft"] = gameStats_["m3_targetsLeft"].GetInt() - 1;
-		}
-	}
+		if (gameState_->GetGameMode())
+			gameState_->GetGameMode()->TargetRemoved(this);
+		break;
 
-	if (ht_pointsIsActive_)
-	{
-		if (ht_pointsTimeLeft_ > 0.0f)
-		{
-			ht_pointsTimeLeft_ -= timeStep;
-		}
-		else
-		{
-			Node * node = GetNode()->GetChild("Points");
-			node->SetEnabled(false);
-			ht_pointsIsActive_ = false;
-		}
-	}
-
-	if (movingSpeed_ > .0f)
-	{
-		GetNode()->Translate(Vector3(.0f, .0f, movingDirection_ ? -movingSpeed_ : movingSpeed_), TS_WORLD);
+	default:
+		break;
 	}
+}
 
-	if (respawnCooldown_ > .0f)
-		respawnCooldown_ -= timeStep;
-	else if(respawn_)
-	{
-		if (gameVars_["gameMode"].GetString() != "none")
-		{
-			respawn_ = false;
-			respawnCooldown_ = .0f;
-			GetNode()->Remove();
+TargetSystem * Target::GetSystem()
+{
+	if (!system_)
+		system_ = GetScene()->GetComponent<TargetSystem>();
 
-			if(controller_)
-				controller_->SetCanCreateTargets(true);
-		}
-	}
+	return system_;
 }
 
-void Target::HandleNodeCollisionStart(StringHash eventType, VariantMap& eventData)
+void Target::OnSceneSet(Scene* scene)
 {
-	if (movingSpeed_ <= .0f)
-		return;
+	// a target leaving the scene must not stay in the system arrays
+	if (!scene && system_)
+		system_->Sleep(this);
 
-	using namespace NodeCollisionStart;
+	LogicComponent::OnSceneSet(scene);
+}
 
-	Node * hitNode = (Node*)eventData[P_OTHERNODE].GetPtr();
+void Target::HT_Hide()
+{
+	ht_isActive_ = false;
 
-	log_->Write(LOG_DEBUG, "Found collision with: " + hitNode->GetName());
+	GetScene()->GetComponent<TweenSystem>()->MoveTo(GetNode(), ht_hiddenPosition_, .25f, EASE_IN_QUAD);
 
-	if (hitNode->GetName() == "TargetTrigger")
+	if (gameState_->GetCounter(GS_TARGETS_LEFT) == 1)
 	{
-		movingDirection_ = !movingDirection_;
-
-		contactCount_++;
-
-		if (gameVars_["gameMode"].GetString() == "mode_2" && contactCount_ > 1)
-		{
-			GetNode()->SetWorldPosition(Vector3(1000.0f, 1000.0f, 1000.0f));
-			respawnCooldown_ = 1.0f;
-			respawn_ = true;
-		}
+		EndRound(GetScene());
 	}
 }
 
@@ -243,7 +200,21 @@ void Target::HT_SetHT(bool toggle)
 	ht_timeLeft_ = 3.0f;
 }
 
+void Target::HT_SetUpTime(float time)
+{
+	ht_timeLeft_ = time;
+}
+
 void Target::HT_SetActive(bool toggle)
 {
 	ht_isActive_ = toggle;
-}
\ No newline at end of file
+
+	if (toggle)
+	{
+		// remember where the target hides while it is still down
+		ht_hiddenPosition_ = GetNode()->GetPosition();
+		GetSystem()->SetTimer(this, TARGET_TIMER_POPUP, ht_timeLeft_);
+	}
+	else
+		GetSystem()->StopTimer(this, TARGET_TIMER_POPUP);
+}
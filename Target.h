@@ -1,6 +1,7 @@
 #pragma once
 
 #include "TargetController.h"
+#include "TargetSystem.h"
 
 #include <Urho3D/Scene/LogicComponent.h>
 #include <Urho3D/Graphics/Renderer.h>
@@ -11,6 +12,9 @@ class Target : public LogicComponent
 {
 	URHO3D_OBJECT(Target, LogicComponent);
 
+	friend class TargetSystem;
+	friend class TargetController;
+
 public:
 	/// Construct.
 	Target(Context* context);
@@ -19,39 +23,51 @@ public:
 	virtual void Start();
 
 	void RegisterHit(float amount, float hitDistance);
-	void SetMovingTarget(float speed, bool direction);
+	/// Clear movement and respawn state so a pooled target can be spawned again.
+	void Reset();
+	/// Move back and forth between two world positions. With a bounce limit the target despawns when it reaches a lane end for that many times.
+	void SetPath(const Vector3& start, const Vector3& end, float speed, unsigned bounceLimit);
 	void SetHealth(float amount);
 	void SetController(TargetController * controller);
+	TargetController * GetController() const { return controller_; }
 
-	void FixedUpdate(float timeStep);
-	void HandleNodeCollisionStart(StringHash eventType, VariantMap& eventData);
+	/// Called by the target system when the path despawn time is reached.
+	void HandlePathEnd();
+	/// Called by the target system when a timer runs out.
+	void HandleTimer(TargetTimer timer);
 
 	void HT_SetVictim(bool toggle);
+	bool HT_IsVictim() const { return ht_isVictim_; }
 	void HT_SetHT(bool toggle);
+	/// How long the human target stays up once it is activated.
+	void HT_SetUpTime(float time);
 	void HT_SetActive(bool toggle);
 
 protected:
 
 	float health_ = 1000.f;
-	bool movingDirection_ = false;
-	float movingSpeed_ = .0f;
-	unsigned int contactCount_ = 0;
-	float respawnCooldown_ = .0f;
-	bool respawn_ = false;
 	bool isActive = false;
 
 	bool ht_isVictim_ = false;
 	bool ht_isHT_ = false;
 	bool ht_isActive_ = false;
 	float ht_timeLeft_ = 0.0f;
-	bool ht_pointsIsActive_ = false;
-	float ht_pointsTimeLeft_ = 0.0f;
+	Vector3 ht_hiddenPosition_;
 
 private:
+
+	virtual void OnSceneSet(Scene* scene);
+	TargetSystem * GetSystem();
+	void HT_Hide();
 	
-	Node * soundNode_;
 	SharedPtr<Node> cameraNode_;
 	SharedPtr<Node> scene_;
 
-	TargetController * controller_;
+	TargetController * controller_ = 0;
+	/// Slot in the live targets of the controller while spawned.
+	unsigned controllerIndex_ = M_MAX_UNSIGNED;
+
+	WeakPtr<TargetSystem> system_;
+	/// Slot in the target system while awake.
+	unsigned systemIndex_ = M_MAX_UNSIGNED;
 };
\ No newline at end of file
@@ -1,13 +1,13 @@
 #include <Urho3D/Core/Context.h>
 #include <Urho3D/Graphics/Model.h>
 #include <Urho3D/Graphics/StaticModel.h>
-#include <Urho3D/Physics/RigidBody.h>
-#include <Urho3D/Physics/CollisionShape.h>
 #include <Urho3D/Resource/ResourceCache.h>
 #include <Urho3D/Scene/Scene.h>
 
 #include "TargetController.h"
 #include "Target.h"
+#include "HitProxy.h"
+#include "Shootable.h"
 #include "Global.h"
 
 TargetController::TargetController(Context* context) :
@@ -20,10 +20,16 @@ TargetController::TargetController(Context* context) :
 void TargetController::RegisterObject(Context* context)
 {
 	context->RegisterFactory<TargetController>();
+
+	URHO3D_ATTRIBUTE("Lane", String, lane_, String::EMPTY, AM_DEFAULT);
 }
 
 void TargetController::Start()
 {
+	// build the targets up front, spawning only resets and enables one of them
+	for (unsigned int i = 0; i < poolSize_; i++)
+		pool_.Push(CreateTarget());
+
 	log_->Write(LOG_DEBUG, "Target Controller created");
 }
 
@@ -34,54 +40,70 @@ void TargetController::AddPairedController(TargetController * target)
 
 void TargetController::SpawnTarget()
 {
-	if (!canCreateTargets_)
+	if (!canCreateTargets_ || !pairedController_)
 		return;
 
-	ResourceCache* cache = GetSubsystem<ResourceCache>();
 	SetRandomSeed(Random(0, M_MAX_INT));
 
 	Node * parentNode;
+	Node * endNode;
 	float rand = Random(-1000.0f, 1000.0f);
 	if (rand >= 500)
 	{
 		parentNode = pairedController_->GetNode();
+		endNode = GetNode();
 	}
 	else
+	{
 		parentNode = GetNode();
+		endNode = pairedController_->GetNode();
+	}
 
-	Node * node = parentNode->CreateChild("Target");
+	if (pool_.Empty())
+	{
+		log_->Write(LOG_DEBUG, "Target pool empty, creating another target");
+		pool_.Push(CreateTarget());
+	}
+
+	Target * target = pool_.Back();
+	pool_.Pop();
+	target->controllerIndex_ = activeTargets_.Size();
+	activeTargets_.Push(target);
+
+	Node * node = target->GetNode();
+	node->SetParent(parentNode);
 	node->SetPosition(Vector3::ZERO);
-	node->SetWorldScale(Vector3::ONE / 75);
 	node->SetWorldRotation(Quaternion(0.0f, 90.0f, 90.0f));
-	node->SetVar("tag", "box");
 
-	StaticModel * object = node->CreateComponent<StaticModel>();
-	object->SetModel(cache->GetResource<Model>("Models/tarcza.mdl"));
-	object->SetMaterial(cache->GetResource<Material>("Materials/tarcza.xml"));
-	object->SetCastShadows(true);
+	// targets run between the two controllers of the lane, the game mode decides how fast and for how long
+	GameMode * mode = gameState_->GetGameMode();
+	float movingSpeed = mode ? mode->GetTargetSpeed() : 6.0f;
+	unsigned bounceLimit = mode ? mode->GetTargetBounceLimit() : 0;
 
-	float movingSpeed = gameVars_["gameMode"].GetString() == "mode_1" ? .1f : .15f;
+	node->SetEnabled(true);
 
-	Target * target = node->CreateComponent<Target>();
-	target->SetMovingTarget(movingSpeed, rand >= 500 ? true : false);
+	target->Reset();
+	target->SetPath(parentNode->GetWorldPosition(), endNode->GetWorldPosition(), movingSpeed, bounceLimit);
 	target->SetHealth(10.f);
-	target->SetController(this);
-
-	RigidBody* body = node->CreateComponent<RigidBody>();
-	body->SetCollisionLayer(1);
-	body->SetMass(1.f);
-	body->SetAngularFactor(Vector3::ZERO);
-	body->SetUseGravity(false);
-	body->SetTrigger(true);
-	body->SetCollisionEventMode(COLLISION_ACTIVE);
-
-	CollisionShape* shape = node->CreateComponent<CollisionShape>();
-	shape->SetBox(Vector3::ONE);
 
 	log_->Write(LOG_DEBUG, "Target spawned!");
 	canCreateTargets_ = false;
 }
 
+void TargetController::ReleaseTarget(Target * target)
+{
+	unsigned index = target->controllerIndex_;
+	if (index >= activeTargets_.Size() || activeTargets_[index] != target)
+		return;
+
+	// swap the last live target into the freed slot
+	activeTargets_[index] = activeTargets_.Back();
+	activeTargets_[index]->controllerIndex_ = index;
+	activeTargets_.Pop();
+
+	Recycle(target);
+}
+
 void TargetController::SetCanCreateTargets(bool opt)
 {
 	canCreateTargets_ = opt;
@@ -89,14 +111,48 @@ void TargetController::SetCanCreateTargets(bool opt)
 
 void TargetController::RemoveChilds()
 {
-	Node * node = GetNode()->GetChild("Target", true);
-	while (node)
-	{
-		node->Remove();
-		node = GetNode()->GetChild("Target", true);
-	}
-		
-	node = pairedController_->GetNode()->GetChild("Target", true);
-	if (node)
-		node->Remove();
+	// every live target of the lane is in the registry, wherever it was parented
+	for (unsigned int i = 0; i < activeTargets_.Size(); i++)
+		Recycle(activeTargets_[i]);
+
+	activeTargets_.Clear();
+}
+
+void TargetController::Recycle(Target * target)
+{
+	target->controllerIndex_ = M_MAX_UNSIGNED;
+	target->Reset();
+
+	Node * node = target->GetNode();
+	node->SetEnabled(false);
+	node->SetParent(GetNode());
+
+	pool_.Push(target);
+}
+
+Target * TargetController::CreateTarget()
+{
+	ResourceCache* cache = GetSubsystem<ResourceCache>();
+
+	Node * node = GetNode()->CreateChild("Target");
+	node->SetPosition(Vector3::ZERO);
+	node->SetWorldScale(Vector3::ONE / 75);
+	node->SetWorldRotation(Quaternion(0.0f, 90.0f, 90.0f));
+
+	Shootable * shootable = node->CreateComponent<Shootable>();
+	shootable->SetKind("box");
+
+	StaticModel * object = node->CreateComponent<StaticModel>();
+	object->SetModel(cache->GetResource<Model>("Models/tarcza.mdl"));
+	object->SetMaterial(cache->GetResource<Material>("Materials/tarcza.xml"));
+	object->SetCastShadows(true);
+	object->SetViewMask(LAYER_TARGETS);
+	AttachHitProxy(object);
+
+	Target * target = node->CreateComponent<Target>();
+	target->SetController(this);
+
+	node->SetEnabled(false);
+
+	return target;
 }
\ No newline at end of file
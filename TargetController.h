@@ -4,6 +4,8 @@
 
 using namespace Urho3D;
 
+class Target;
+
 class TargetController : public LogicComponent
 {
 	URHO3D_OBJECT(TargetController, LogicComponent);
@@ -17,11 +19,27 @@ public:
 
 	void AddPairedController(TargetController * target);
 	void SpawnTarget();
+	/// Disable a target spawned by this controller and return it to the pool.
+	void ReleaseTarget(Target * target);
 	void SetCanCreateTargets(bool opt);
+	/// Return every live target of this controller to the pool in one pass.
 	void RemoveChilds();
 
+	const String& GetLane() const { return lane_; }
+
+	/// Number of targets built when the controller starts.
+	unsigned poolSize_ = 2;
+
 private:
 
+	Target * CreateTarget();
+	void Recycle(Target * target);
+
 	bool canCreateTargets_ = false;
-	TargetController * pairedController_;
+	TargetController * pairedController_ = 0;
+	/// Controllers with the same lane name are the two ends of one lane.
+	String lane_;
+
+	PODVector<Target *> pool_;
+	PODVector<Target *> activeTargets_;
 };
\ No newline at end of file
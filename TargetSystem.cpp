@@ -0,0 +1,171 @@
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Scene/Node.h>
+
+#include "TargetSystem.h"
+#include "Target.h"
+#include "Global.h"
+
+TargetSystem::TargetSystem(Context* context) :
+	LogicComponent(context)
+{
+	// Only the physics update event is needed: unsubscribe from the rest for optimization
+	SetUpdateEventMask(USE_FIXEDUPDATE);
+}
+
+void TargetSystem::RegisterObject(Context* context)
+{
+	context->RegisterFactory<TargetSystem>();
+}
+
+void TargetSystem::FixedUpdate(float timeStep)
+{
+	unsigned int i = 0;
+	while (i < targets_.Size())
+	{
+		bool idle = true;
+
+		if (pathSpeeds_[i] > .0f)
+		{
+			pathTimes_[i] += timeStep;
+
+			if (despawnTimes_[i] >= .0f && pathTimes_[i] >= despawnTimes_[i])
+			{
+				TargetEvent event = { targets_[i], -1 };
+				pathSpeeds_[i] = .0f;
+				events_.Push(event);
+			}
+			else
+			{
+				// position is a closed-form function of the time on the path, every leg reverses the direction
+				float distance = pathSpeeds_[i] * pathTimes_[i];
+				unsigned legs = (unsigned)(distance / pathLengths_[i]);
+				float t = (distance - legs * pathLengths_[i]) / pathLengths_[i];
+
+				targets_[i]->GetNode()->SetWorldPosition(legs % 2 == 0 ? pathStarts_[i].Lerp(pathEnds_[i], t) : pathEnds_[i].Lerp(pathStarts_[i], t));
+				idle = false;
+			}
+		}
+
+		for (unsigned int x = 0; x < MAX_TARGET_TIMERS; x++)
+		{
+			float& time = timers_[x][i];
+			if (time < .0f)
+				continue;
+
+			time -= timeStep;
+			if (time <= .0f)
+			{
+				TargetEvent event = { targets_[i], (int)x };
+				time = -1.0f;
+				events_.Push(event);
+			}
+			else
+				idle = false;
+		}
+
+		if (idle)
+			Remove(i);
+		else
+			i++;
+	}
+
+	// notify after the loop so handlers are free to wake, stop or sleep any target
+	for (unsigned int x = 0; x < events_.Size(); x++)
+	{
+		if (events_[x].timer_ < 0)
+			events_[x].target_->HandlePathEnd();
+		else
+			events_[x].target_->HandleTimer((TargetTimer)events_[x].timer_);
+	}
+	events_.Clear();
+}
+
+void TargetSystem::SetPath(Target * target, const Vector3& start, const Vector3& end, float speed, float despawnTime)
+{
+	unsigned index = Wake(target);
+
+	pathStarts_[index] = start;
+	pathEnds_[index] = end;
+	pathLengths_[index] = (end - start).Length();
+	pathSpeeds_[index] = pathLengths_[index] > M_EPSILON ? speed : .0f;
+	pathTimes_[index] = .0f;
+	despawnTimes_[index] = despawnTime;
+
+	target->GetNode()->SetWorldPosition(start);
+}
+
+void TargetSystem::StopPath(Target * target)
+{
+	if (target->systemIndex_ != M_MAX_UNSIGNED)
+		pathSpeeds_[target->systemIndex_] = .0f;
+}
+
+void TargetSystem::SetTimer(Target * target, TargetTimer timer, float time)
+{
+	timers_[timer][Wake(target)] = time;
+}
+
+void TargetSystem::StopTimer(Target * target, TargetTimer timer)
+{
+	if (target->systemIndex_ != M_MAX_UNSIGNED)
+		timers_[timer][target->systemIndex_] = -1.0f;
+}
+
+void TargetSystem::Sleep(Target * target)
+{
+	if (target->systemIndex_ != M_MAX_UNSIGNED)
+		Remove(target->systemIndex_);
+}
+
+unsigned TargetSystem::Wake(Target * target)
+{
+	if (target->systemIndex_ != M_MAX_UNSIGNED)
+		return target->systemIndex_;
+
+	unsigned index = targets_.Size();
+	target->systemIndex_ = index;
+
+	targets_.Push(target);
+	pathStarts_.Push(Vector3::ZERO);
+	pathEnds_.Push(Vector3::ZERO);
+	pathLengths_.Push(.0f);
+	pathSpeeds_.Push(.0f);
+	pathTimes_.Push(.0f);
+	despawnTimes_.Push(-1.0f);
+	for (unsigned int x = 0; x < MAX_TARGET_TIMERS; x++)
+		timers_[x].Push(-1.0f);
+
+	return index;
+}
+
+void TargetSystem::Remove(unsigned index)
+{
+	// keep the awake targets packed by moving the last one into the freed slot
+	unsigned last = targets_.Size() - 1;
+
+	targets_[index]->systemIndex_ = M_MAX_UNSIGNED;
+
+	if (index != last)
+	{
+		targets_[index] = targets_[last];
+		targets_[index]->systemIndex_ = index;
+		pathStarts_[index] = pathStarts_[last];
+		pathEnds_[index] = pathEnds_[last];
+		pathLengths_[index] = pathLengths_[last];
+		pathSpeeds_[index] = pathSpeeds_[last];
+		pathTimes_[index] = pathTimes_[last];
+		despawnTimes_[index] = despawnTimes_[last];
+		for (unsigned int x = 0; x < MAX_TARGET_TIMERS; x++)
+			timers_[x][index] = timers_[x][last];
+	}
+
+	targets_.Pop();
+	pathStarts_.Pop();
+	pathEnds_.Pop();
+	pathLengths_.Pop();
+	pathSpeeds_.Pop();
+	pathTimes_.Pop();
+	despawnTimes_.Pop();
+	for (unsigned int x = 0; x < MAX_TARGET_TIMERS; x++)
+		timers_[x].Pop();
+}
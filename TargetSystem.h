@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Urho3D/Scene/LogicComponent.h>
+
+using namespace Urho3D;
+
+class Target;
+
+enum TargetTimer
+{
+	TARGET_TIMER_POPUP = 0,
+	TARGET_TIMER_POINTS,
+	TARGET_TIMER_RESPAWN,
+	MAX_TARGET_TIMERS
+};
+
+/// Updates every awake target in one pass per physics step. Path motion and timers of awake targets are stored in parallel
+/// arrays packed at the front; a target with no motion and no running timer is put to sleep and costs nothing until woken.
+class TargetSystem : public LogicComponent
+{
+	URHO3D_OBJECT(TargetSystem, LogicComponent);
+
+public:
+	/// Construct.
+	TargetSystem(Context* context);
+
+	static void RegisterObject(Context* context);
+
+	void FixedUpdate(float timeStep);
+
+	/// Start moving a target back and forth between two world positions. A despawn time below zero keeps it moving.
+	void SetPath(Target * target, const Vector3& start, const Vector3& end, float speed, float despawnTime);
+	void StopPath(Target * target);
+	/// Start a timer; the target is notified through Target::HandleTimer when it runs out.
+	void SetTimer(Target * target, TargetTimer timer, float time);
+	void StopTimer(Target * target, TargetTimer timer);
+	/// Stop all motion and timers of a target and remove it from the update.
+	void Sleep(Target * target);
+
+	unsigned GetNumAwake() const { return targets_.Size(); }
+
+private:
+
+	struct TargetEvent
+	{
+		Target * target_;
+		int timer_;
+	};
+
+	unsigned Wake(Target * target);
+	void Remove(unsigned index);
+
+	PODVector<Target *> targets_;
+	PODVector<Vector3> pathStarts_;
+	PODVector<Vector3> pathEnds_;
+	PODVector<float> pathLengths_;
+	PODVector<float> pathSpeeds_;
+	PODVector<float> pathTimes_;
+	PODVector<float> despawnTimes_;
+	PODVector<float> timers_[MAX_TARGET_TIMERS];
+
+	PODVector<TargetEvent> events_;
+};
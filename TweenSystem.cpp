@@ -0,0 +1,147 @@
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Scene/Node.h>
+
+#include "TweenSystem.h"
+
+TweenSystem::TweenSystem(Context* context) :
+	LogicComponent(context)
+{
+	// Tweens are only visual, they follow the rendered frame
+	SetUpdateEventMask(USE_UPDATE);
+}
+
+void TweenSystem::RegisterObject(Context* context)
+{
+	context->RegisterFactory<TweenSystem>();
+}
+
+void TweenSystem::Update(float timeStep)
+{
+	unsigned int i = 0;
+	while (i < tweens_.Size())
+	{
+		Tween& tween = tweens_[i];
+		Node * node = tween.node_;
+
+		if (!node)
+		{
+			Remove(i);
+			continue;
+		}
+
+		if (tween.delay_ > .0f)
+		{
+			tween.delay_ -= timeStep;
+			if (tween.delay_ > .0f)
+			{
+				i++;
+				continue;
+			}
+
+			// the delay is over, the leftover time counts as already animated
+			tween.time_ = -tween.delay_;
+			tween.from_ = node->GetPosition();
+
+			if (tween.onStart_)
+			{
+				TweenEvent event = { tween.node_, tween.onStart_ };
+				events_.Push(event);
+			}
+		}
+		else
+			tween.time_ += timeStep;
+
+		if (tween.time_ >= tween.duration_)
+		{
+			node->SetPosition(tween.to_);
+
+			if (tween.onFinish_)
+			{
+				TweenEvent event = { tween.node_, tween.onFinish_ };
+				events_.Push(event);
+			}
+
+			Remove(i);
+			continue;
+		}
+
+		node->SetPosition(tween.from_.Lerp(tween.to_, Ease(tween.ease_, tween.time_ / tween.duration_)));
+		i++;
+	}
+
+	// notify after the loop so handlers are free to start or stop tweens
+	for (unsigned int x = 0; x < events_.Size(); x++)
+	{
+		if (events_[x].node_)
+			events_[x].handler_(events_[x].node_);
+	}
+	events_.Clear();
+}
+
+void TweenSystem::MoveTo(Node * node, const Vector3& position, float duration, TweenEase ease, float delay, TweenHandler onStart, TweenHandler onFinish)
+{
+	Stop(node);
+
+	Tween tween;
+	tween.node_ = node;
+	tween.from_ = node->GetPosition();
+	tween.to_ = position;
+	tween.delay_ = delay;
+	tween.duration_ = Max(duration, M_EPSILON);
+	tween.time_ = .0f;
+	tween.ease_ = ease;
+	tween.onStart_ = onStart;
+	tween.onFinish_ = onFinish;
+
+	if (delay <= .0f && onStart)
+		onStart(node);
+
+	tweens_.Push(tween);
+}
+
+void TweenSystem::Stop(Node * node)
+{
+	for (unsigned int i = 0; i < tweens_.Size(); i++)
+	{
+		if (tweens_[i].node_ == node)
+		{
+			Remove(i);
+			return;
+		}
+	}
+}
+
+float TweenSystem::Ease(TweenEase ease, float t)
+{
+	switch (ease)
+	{
+	case EASE_IN_QUAD:
+		return t * t;
+
+	case EASE_OUT_QUAD:
+		return t * (2.0f - t);
+
+	case EASE_IN_OUT_QUAD:
+		return t < .5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+
+	case EASE_OUT_BACK:
+	{
+		// overshoots the end a little and settles back
+		const float overshoot = 1.70158f;
+		float u = t - 1.0f;
+		return 1.0f + u * u * ((overshoot + 1.0f) * u + overshoot);
+	}
+
+	default:
+		return t;
+	}
+}
+
+void TweenSystem::Remove(unsigned index)
+{
+	// order of the tweens does not matter, move the last one into the freed slot
+	if (index != tweens_.Size() - 1)
+		tweens_[index] = tweens_.Back();
+
+	tweens_.Pop();
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Urho3D/Scene/LogicComponent.h>
+
+using namespace Urho3D;
+
+enum TweenEase
+{
+	EASE_LINEAR = 0,
+	EASE_IN_QUAD,
+	EASE_OUT_QUAD,
+	EASE_IN_OUT_QUAD,
+	EASE_OUT_BACK
+};
+
+typedef void (*TweenHandler)(Node * node);
+
+/// Moves nodes along easing curves. All running tweens are advanced in one loop per rendered frame, so the motion does
+/// not depend on the physics step. A node has at most one tween, starting another one replaces it.
+class TweenSystem : public LogicComponent
+{
+	URHO3D_OBJECT(TweenSystem, LogicComponent);
+
+public:
+	/// Construct.
+	TweenSystem(Context* context);
+
+	static void RegisterObject(Context* context);
+
+	void Update(float timeStep);
+
+	/// Move a node from its current position to a position in parent space. The start handler runs after the delay,
+	/// the finish handler when the node arrives.
+	void MoveTo(Node * node, const Vector3& position, float duration, TweenEase ease = EASE_LINEAR, float delay = .0f,
+		TweenHandler onStart = 0, TweenHandler onFinish = 0);
+	/// Stop the tween of a node where it is, without calling its finish handler.
+	void Stop(Node * node);
+
+	unsigned GetNumActive() const { return tweens_.Size(); }
+
+	static float Ease(TweenEase ease, float t);
+
+private:
+
+	struct Tween
+	{
+		WeakPtr<Node> node_;
+		Vector3 from_;
+		Vector3 to_;
+		float delay_;
+		float duration_;
+		float time_;
+		TweenEase ease_;
+		TweenHandler onStart_;
+		TweenHandler onFinish_;
+	};
+
+	struct TweenEvent
+	{
+		WeakPtr<Node> node_;
+		TweenHandler handler_;
+	};
+
+	void Remove(unsigned index);
+
+	Vector<Tween> tweens_;
+	Vector<TweenEvent> events_;
+};
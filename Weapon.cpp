@@ -39,6 +39,12 @@
 #include <Urho3D/UI/Window.h>
 
 #include "Weapon.h"
+#include "DecalManager.h"
+#include "HitProxy.h"
+#include "ProjectileSystem.h"
+#include "Shootable.h"
+#include "ShotLightManager.h"
+#include "SoundPool.h"
 #include "Global.h"
 #include "Target.h"
 #include "HumanTargetController.h"
@@ -55,43 +61,26 @@ void Weapon::RegisterObject(Context* context)
 	context->RegisterFactory<Weapon>();
 }
 
-void Weapon::Setup(Vector<Window *> * wh, Sprite * wc, Window * rw, Text * rt)
-{
-	wh_ = wh;
-	weaponCrosshair_ = wc;
-	resultWindow_ = rw;
-	resultText_ = rt;
-}
-
 void Weapon::Start()
 {
 	ResourceCache* cache = GetSubsystem<ResourceCache>();
-	UI* ui = GetSubsystem<UI>();
-
-	XMLFile* style = cache->GetResource<XMLFile>("UI/DefaultStyle.xml");
-	ui->GetRoot()->SetDefaultStyle(style);
-
-	pointsText_ = ui->GetRoot()->CreateChild<Text>();
-	pointsText_->SetText(
-		"Points: 0"
-	);
-	pointsText_->SetFont(cache->GetResource<Font>("Fonts/Prototype.ttf"), 20);
-	pointsText_->SetTextAlignment(HA_LEFT);
-	pointsText_->SetPosition(10, 10);
-
-	timerText_ = ui->GetRoot()->CreateChild<Text>();
-	timerText_->SetText(
-		"Time left: 0s"
-	);
-	timerText_->SetFont(cache->GetResource<Font>("Fonts/Prototype.ttf"), 20);
-	timerText_->SetTextAlignment(HA_RIGHT);
-	timerText_->SetPosition(-10, 10);
-	timerText_->SetAlignment(HA_RIGHT, VA_TOP);
 
 	cameraNode_ = GetScene()->GetChild("CameraNode");
-	shotLightNode_ = GetNode()->GetChild("WeaponShotLightNode");
-	shotFireNode_ = GetNode()->GetChild("WeaponShotFireNode");
-	soundNode_ = GetScene()->CreateChild("SoundNode");
+	soundPool_ = GetScene()->GetComponent<SoundPool>();
+	projectiles_ = GetScene()->GetComponent<ProjectileSystem>();
+	decalManager_ = GetScene()->GetComponent<DecalManager>();
+	shotLights_ = GetScene()->GetComponent<ShotLightManager>();
+
+	for (unsigned int i = 0; i < weaponDefs_.Size(); i++)
+	{
+		Node * viewModelNode = GetNode()->GetChild(weaponDefs_[i].name_);
+
+		viewModels_.Push(viewModelNode);
+		fireNodes_.Push(viewModelNode->GetChild("WeaponShotFireNode"));
+		shotSounds_.Push(SharedPtr<Sound>(cache->GetResource<Sound>(weaponDefs_[i].sound_)));
+	}
+
+	ChangeWeapon(gameState_->GetSelectedWeapon());
 }
 
 void Weapon::FixedUpdate(float timeStep)
@@ -104,28 +93,21 @@ void Weapon::FixedUpdate(float timeStep)
 	{
 		if (canShootNextBullet)
 		{
-			if (timeCounter_ - lastShoot_ > weaponsData_[gameVars_["selectedWeapon"].GetString()]["shootingInterval"].GetFloat())
+			if (timeCounter_ - lastShoot_ > weaponDef_->shootingInterval_)
 			{
 				CreateBullet();
 
 				lastShoot_ = timeCounter_;
 
-				ResourceCache* cache = GetSubsystem<ResourceCache>();
-				Sound* sound = cache->GetResource<Sound>(weaponsData_[gameVars_["selectedWeapon"].GetString()]["sound"].GetString());
-
-				SoundSource* soundSource = GetScene()->CreateComponent<SoundSource>();
-				soundSource->Play(sound);
-				soundSource->SetGain(.75f);
+				soundPool_->Play(shotSound_, VOICE_GUNFIRE, .75f, 1);
 
-				FindHit();
-
-				if (!weaponsData_[gameVars_["selectedWeapon"].GetString()]["automatic"].GetBool())
+				if (!weaponDef_->automatic_)
 				{
 					canShootNextBullet = false;
 				}
 			}
 
-			if (lastUpdateShoot_ == true && burstCounter_ < weaponsData_[gameVars_["selectedWeapon"].GetString()]["maxSpreadTime"].GetFloat())
+			if (lastUpdateShoot_ == true && burstCounter_ < weaponDef_->maxSpreadTime_)
 			{
 				burstCounter_ += timeStep;
 			}
@@ -142,295 +124,97 @@ void Weapon::FixedUpdate(float timeStep)
 
 	if (controls_.IsDown(CTRL_PRIMARY))
 	{
-		gameVars_["selectedWeapon"] = gameVars_["primaryWeapon"];
-		ChangeWeapon(gameVars_["selectedWeapon"].GetString());
+		ChangeWeapon(gameState_->primaryWeapon_);
 	}
 	if (controls_.IsDown(CTRL_SECONDARY))
 	{
-		gameVars_["selectedWeapon"] = gameVars_["secondaryWeapon"];
-		ChangeWeapon(gameVars_["selectedWeapon"].GetString());
+		ChangeWeapon(gameState_->secondaryWeapon_);
 	}
 
 	if (shotFireEnabledTime_ > 0.05f)
 	{
-		shotLightNode_->SetEnabled(false);
 		shotFireNode_->SetEnabled(false);
 	}
 	else
 		shotFireEnabledTime_ += timeStep;
-
-	// Time Control
-
-	if (gameVars_["gameMode"].GetString() == "mode_3")
-	{
-		gameVars_["timeLeft"] = gameVars_["timeLeft"].GetFloat() + timeStep;
-	}
-	else
-	{
-		if (gameVars_["timeLeft"].GetFloat() > 0.0f)
-		{
-			gameVars_["timeLeft"] = gameVars_["timeLeft"].GetFloat() - timeStep;
-		}
-		else if (gameVars_["gameMode"].GetString() != "none")
-		{
-			gameVars_["timeLeft"] = 0.0f;
-			gameVars_["lastMode"] = gameVars_["gameMode"];
-			gameVars_["gameMode"] = "none";
-			for (unsigned int i = 0; i < targetControllers_.Size(); i++)
-			{
-				targetControllers_[i]->SetCanCreateTargets(false);
-				targetControllers_[i]->RemoveChilds();
-			}
-
-			float accuracy = gameStats_["shotsHit"].GetFloat() / gameStats_["shotsFired"].GetFloat();
-			char s[20];
-			sprintf(s, "%0.2f", accuracy * 100);
-			String str = s;
-
-			int finalScore = 0;
-			if (gameStats_["points"].GetInt() > 0)
-				finalScore = (int)ceil(gameStats_["points"].GetInt() * (accuracy + ((1 - accuracy) / 2)));
-
-			resultText_->SetText(
-				"Points earned: " + (String)gameStats_["points"] + "\n"
-				"Accuracy: " + s + "%\n"
-				"Targets destroyed: " + (String)gameStats_["targetsDestroyed"] + "\n\n"
-				"FINAL SCORE: " + (String)finalScore + " !!!"
-			);
-
-			gameVars_["tempPoints"] = finalScore;
-			gameStats_["shotsFired"] = 0;
-			gameStats_["shotsHit"] = 0;
-			gameStats_["targetsDestroyed"] = 0;
-			gameStats_["targetMissed"] = 0;
-			gameStats_["points"] = 0;
-
-			resultWindow_->SetVisible(true);
-			wh_->Push(resultWindow_);
-			input->SetMouseVisible(true);
-			weaponCrosshair_->SetVisible(false);
-		}
-	}
-
-	// update UI
-	pointsText_->SetText(
-		"Points: " + (String)gameStats_["points"] + "\n"
-		"Shots Fired: " + (String)gameStats_["shotsFired"] + "\n"
-		"Targets Hit: " + (String)gameStats_["targetsDestroyed"] + "\n"
-	);
-
-	char s[20];
-	sprintf(s, "%0.2f", gameVars_["timeLeft"].GetFloat());
-	String str = s;
-
-	if (gameVars_["gameMode"].GetString() == "mode_1" || gameVars_["gameMode"].GetString() == "mode_2")
-	{
-		timerText_->SetText(
-			"Time Left: " + str + "s\n"
-		);
-	}
-	else if (gameVars_["gameMode"].GetString() == "mode_3")
-	{
-		timerText_->SetText(
-			"Time Elapsed: " + str + "s\n"
-			"Targets: " + (String)gameStats_["m3_targetsLeft"].GetInt() + " / 18"
-		);
-	}
-	else
-	{
-		timerText_->SetText("");
-	}
-	
 }
 
 void Weapon::CreateBullet()
 {
-	ResourceCache* cache = GetSubsystem<ResourceCache>();
-	Node * bulletNode = GetScene()->CreateChild("BulletNode");
-
-	Vector3 pos = GetNode()->GetWorldPosition() + GetNode()->GetWorldRotation() * weaponsData_[gameVars_["selectedWeapon"].GetString()]["muzzlePosition"].GetVector3();
-
-	bulletNode->SetPosition(pos);
-	bulletNode->SetWorldScale(weaponsData_[gameVars_["selectedWeapon"].GetString()]["bulletScale"].GetVector3());
-	bulletNode->SetWorldRotation(cameraNode_->GetWorldRotation());
+	Ray shotRay = GetShotRay();
 
-	StaticModel * object = bulletNode->CreateComponent<StaticModel>();
-	object->SetModel(cache->GetResource<Model>("Models/Bullet.mdl"));
-	object->SetMaterial(cache->GetResource<Material>("Materials/Bullet.xml"));
+	projectiles_->Fire(this, shotRay.origin_, shotRay.direction_,
+		weaponDef_->muzzleVelocity_,
+		weaponDef_->drag_);
 
-	// Create rigidbody, and set non-zero mass so that the body becomes dynamic
-	RigidBody* body = bulletNode->CreateComponent<RigidBody>();
-	body->SetMass(0.03f);
-	body->SetUseGravity(false);
-	body->SetTrigger(true);
-	body->SetLinearVelocity((bulletNode->GetWorldRotation()) * Vector3(0, 0, 1) * 100.0f);
+	Node * viewModelNode = viewModels_[weaponIndex_];
+	shotLights_->Flash(viewModelNode->GetWorldPosition() + viewModelNode->GetWorldRotation() * weaponDef_->muzzlePosition_,
+		viewModelNode->GetWorldRotation() * weaponDef_->lightRotation_);
 
-	shotLightNode_->SetEnabled(true);
 	shotFireNode_->SetEnabled(true);
 	shotFireEnabledTime_ = .0f;
 
-	gameStats_["shotsFired"] = gameStats_["shotsFired"].GetInt() + 1;
+	gameState_->AddCounter(GS_SHOTS_FIRED);
 }
 
-void Weapon::FindHit()
+void Weapon::FindHit(const Vector3& hitPos, Drawable * hitDrawable, float hitDistance)
 {
-	Vector3 hitPos;
-	Drawable* hitDrawable;
-	float hitDistance;
-
-	if(Raycast(250.0f, hitPos, hitDrawable, hitDistance))
+	Shootable * shootable = hitDrawable->GetNode()->GetComponent<Shootable>();
+	if (shootable)
 	{
-		if (hitDrawable->GetNode()->GetVar("tag").ToString() == "box" || hitDrawable->GetNode()->GetVar("tag").ToString() == "human_target")
-		{
-			Target * target = hitDrawable->GetNode()->GetComponent<Target>();
-			if (target)
-				target->RegisterHit(20.0f, hitDistance);
-
-			gameStats_["shotsHit"] = gameStats_["shotsHit"].GetInt() + 1;
-
-			ResourceCache* cache = GetSubsystem<ResourceCache>();
-			Sound* sound = cache->GetResource<Sound>("Sounds/metal.wav");
-
-			SoundSource* soundSource = soundNode_->CreateComponent<SoundSource>();
-			soundSource->Play(sound);
-			soundSource->SetGain(1.0f);
-		}
-		else if (hitDrawable->GetNode()->GetVar("tag").ToString() == "start_button_1" && gameVars_["gameMode"].GetString() == "none")
-		{
-			for (unsigned int i = 0; i < targetControllers_.Size(); i++)
-			{
-				if (targetControllers_[i]->GetNode()->GetVar("type").GetString() == "mode_1")
-				{
-					targetControllers_[i]->SetCanCreateTargets(true);
-				}
-				else
-					targetControllers_[i]->SetCanCreateTargets(false);
-			}
-			gameVars_["gameMode"] = "mode_1";
-			gameVars_["timeLeft"] = 30.0f;
-
-			gameStats_["shotsFired"] = 0;
-			gameStats_["shotsHit"] = 0;
-			gameStats_["targetsDestroyed"] = 0;
-			gameStats_["targetMissed"] = 0;
-			gameStats_["points"] = 0;
-		}
-		else if (hitDrawable->GetNode()->GetVar("tag").ToString() == "start_button_2" && gameVars_["gameMode"].GetString() == "none")
-		{
-			for (unsigned int i = 0; i < targetControllers_.Size(); i++)
-			{
-				if (targetControllers_[i]->GetNode()->GetVar("type").GetString() == "mode_1")
-				{
-					targetControllers_[i]->SetCanCreateTargets(true);
-				}
-				else
-					targetControllers_[i]->SetCanCreateTargets(false);
-			}
-
-			gameVars_["gameMode"] = "mode_2";
-			gameVars_["timeLeft"] = 30.0f;
-
-			gameStats_["shotsFired"] = 0;
-			gameStats_["shotsHit"] = 0;
-			gameStats_["targetsDestroyed"] = 0;
-			gameStats_["targetMissed"] = 0;
-			gameStats_["points"] = 0;
-		}
-		else if (hitDrawable->GetNode()->GetVar("tag").ToString() == "start_button_4" && gameVars_["gameMode"].GetString() == "none")
-		{
-			gameVars_["gameMode"] = "mode_3";
-			gameVars_["timeLeft"] = .0f;
-
-			gameStats_["shotsFired"] = 0;
-			gameStats_["shotsHit"] = 0;
-			gameStats_["targetsDestroyed"] = 0;
-			gameStats_["targetMissed"] = 0;
-			gameStats_["points"] = 0;
-			gameStats_["m3_targetsLeft"] = 18;
-
-			HumanTargetController * ht_controller = GetScene()->GetComponent<HumanTargetController>();
-			ht_controller->ResetTargets();
-		}
-		else
-		{
-			PaintDecal(hitPos, hitDrawable);
-		}
+		ShotHit hit;
+		hit.shooter_ = this;
+		hit.drawable_ = hitDrawable;
+		hit.position_ = hitPos;
+		hit.distance_ = hitDistance;
+
+		if (shootable->HandleHit(hit))
+			return;
 	}
+
+	PaintDecal(hitPos, hitDrawable);
 }
 
-bool Weapon::Raycast(float maxDistance, Vector3& hitPos, Drawable*& hitDrawable, float& hitDistance)
+Ray Weapon::GetShotRay()
 {
-	hitDrawable = 0;
-
 	UI* ui = GetSubsystem<UI>();
 	SetRandomSeed(Random(1, M_MAX_INT));
-	Vector2 spread = Vector2(Random(-burstCounter_, burstCounter_), Random(-burstCounter_, 0.0f)) * weaponsData_[gameVars_["selectedWeapon"].GetString()]["spreadFactor"].GetFloat();
+	Vector2 spread = Vector2(Random(-burstCounter_, burstCounter_), Random(-burstCounter_, 0.0f)) * weaponDef_->spreadFactor_;
 	IntVector2 pos = ui->GetCursorPosition();
 
 	Graphics* graphics = GetSubsystem<Graphics>();
 	Camera* camera = cameraNode_->GetComponent<Camera>();
-	Ray cameraRay = camera->GetScreenRay(((float)pos.x_ + spread.x_) / graphics->GetWidth(), ((float)pos.y_ + spread.y_) / graphics->GetHeight());
-	PODVector<RayQueryResult> results;
-	RayOctreeQuery query(results, cameraRay, RAY_TRIANGLE, maxDistance, DRAWABLE_GEOMETRY);
-	GetScene()->GetComponent<Octree>()->RaycastSingle(query);
-	if (results.Size())
-	{
-		RayQueryResult& result = results[0];
-		hitPos = result.position_;
-		hitDistance = result.distance_;
-		hitDrawable = result.drawable_;
-		return true;
-	}
-
-	return false;
+	return camera->GetScreenRay(((float)pos.x_ + spread.x_) / graphics->GetWidth(), ((float)pos.y_ + spread.y_) / graphics->GetHeight());
 }
 
-void Weapon::ChangeWeapon(String weaponName)
+void Weapon::ChangeWeapon(int weaponIndex)
 {
-	ResourceCache* cache = GetSubsystem<ResourceCache>();
+	if (weaponIndex == weaponIndex_ || weaponIndex < 0 || weaponIndex >= (int)viewModels_.Size())
+		return;
 
-	Node * weaponNode = GetNode();
-	weaponNode->SetPosition(weaponsData_[weaponName]["position"].GetVector3());
-	weaponNode->SetWorldScale(weaponsData_[weaponName]["scale"].GetVector3());
-	weaponNode->SetRotation(weaponsData_[weaponName]["rotation"].GetQuaternion());
+	if (weaponIndex_ >= 0)
+	{
+		shotFireNode_->SetEnabled(false);
+		viewModels_[weaponIndex_]->SetEnabled(false);
+	}
 
-	StaticModel * object = weaponNode->GetComponent<StaticModel>();
-	object->SetModel(cache->GetResource<Model>(weaponsData_[weaponName]["model"].GetString()));
-	object->SetMaterial(cache->GetResource<Material>(weaponsData_[weaponName]["material"].GetString()));
-	object->SetCastShadows(true);
+	weaponIndex_ = weaponIndex;
+	weaponDef_ = &weaponDefs_[weaponIndex];
+	shotSound_ = shotSounds_[weaponIndex];
+	shotFireNode_ = fireNodes_[weaponIndex];
+	viewModels_[weaponIndex]->SetEnabled(true);
 
-	shotLightNode_->SetWorldPosition(weaponNode->GetWorldPosition() + weaponNode->GetWorldRotation() * weaponsData_[weaponName]["muzzlePosition"].GetVector3());
-	shotLightNode_->SetRotation(weaponsData_[weaponName]["lightRotation"].GetQuaternion());
-	shotFireNode_->SetWorldPosition(weaponNode->GetWorldPosition() + weaponNode->GetWorldRotation() * weaponsData_[weaponName]["muzzlePosition"].GetVector3());
-	shotFireNode_->SetRotation(weaponsData_[weaponName]["fireRotation"].GetQuaternion());
+	gameState_->SetSelectedWeapon(weaponIndex);
 
 	burstCounter_ = .0f;
 }
 
 void Weapon::PaintDecal(Vector3 hitPos, Drawable * hitDrawable)
 {
-	// Check if target scene node already has a DecalSet component. If not, create now
-	Node* targetNode = hitDrawable->GetNode();
-	if (!targetNode)
-		return;
-
-	if (targetNode->GetName() == "WeaponShotFireNode")
-		return;
-
-	DecalSet* decal = targetNode->GetComponent<DecalSet>();
-	if (!decal)
-	{
-		ResourceCache* cache = GetSubsystem<ResourceCache>();
-
-		decal = targetNode->CreateComponent<DecalSet>();
-		decal->SetMaterial(cache->GetResource<Material>("Materials/BulletHole.xml"));
-	}
-
 	if (!cameraNode_)
 	{
 		cameraNode_ = GetScene()->GetChild("CameraNode");
 	}
 
-	decal->AddDecal(hitDrawable, hitPos, cameraNode_->GetRotation(), 0.2f, 1.0f, 1.0f, Vector2::ZERO,
-		Vector2::ONE);
+	decalManager_->AddDecal(GetVisualForHit(hitDrawable), hitPos, cameraNode_->GetRotation(), 0.2f);
 }
\ No newline at end of file
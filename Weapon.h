@@ -1,10 +1,20 @@
 #pragma once
 
+#include <Urho3D/Audio/Sound.h>
+#include <Urho3D/Graphics/Drawable.h>
 #include <Urho3D/Input/Controls.h>
+#include <Urho3D/Math/Ray.h>
 #include <Urho3D/Scene/LogicComponent.h>
 
+#include "WeaponDef.h"
+
 using namespace Urho3D;
 
+class DecalManager;
+class ProjectileSystem;
+class ShotLightManager;
+class SoundPool;
+
 const int CTRL_PRIMARY = 1;
 const int CTRL_SECONDARY = 2;
 
@@ -19,10 +29,12 @@ public:
 	Controls controls_;
 
 	static void RegisterObject(Context* context);
-	virtual void Setup(Vector<Window *> * wh, Sprite * wc, Window * rw, Text * rt);
 	virtual void Start();
 	void FixedUpdate(float timeStep);
 
+	/// Resolve a round that hit a drawable after travelling hitDistance. Called by the ProjectileSystem.
+	void FindHit(const Vector3& hitPos, Drawable * hitDrawable, float hitDistance);
+
 private:
 
 	bool lastUpdateShoot_ = false;
@@ -34,26 +46,25 @@ private:
 	float shotFireEnabledTime_ = .0f;
 	
 	SharedPtr<Node> cameraNode_;
-	WeakPtr<Node> shotLightNode_;
 	WeakPtr<Node> shotFireNode_;
 
-	Node * soundNode_;
-
-	Window * resultWindow_;
-
-	Text * pointsText_;
-	Text * timerText_;
-	Text * resultText_;
+	ProjectileSystem * projectiles_;
+	SoundPool * soundPool_;
+	DecalManager * decalManager_;
+	ShotLightManager * shotLights_;
 
-	Vector<Window *> * wh_;
+	PODVector<Node *> viewModels_;
+	PODVector<Node *> fireNodes_;
+	Vector<SharedPtr<Sound> > shotSounds_;
 
-	Sprite * weaponCrosshair_;
+	int weaponIndex_ = -1;
+	const WeaponDef * weaponDef_ = 0;
+	SharedPtr<Sound> shotSound_;
 
-	void ChangeWeapon(String weaponName);
+	void ChangeWeapon(int weaponIndex);
 	
 	void CreateBullet();
-	void FindHit();
 	void PaintDecal(Vector3 hitPos, Drawable * hitDrawable);
 
-	bool Raycast(float maxDistance, Vector3& hitPos, Drawable*& hitDrawable, float& hitDistance);
+	Ray GetShotRay();
 };
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/XMLFile.h>
+
+#include "WeaponDef.h"
+#include "Global.h"
+
+bool LoadWeaponDefs(Context * context, const String& resourceName)
+{
+	ResourceCache* cache = context->GetSubsystem<ResourceCache>();
+	XMLFile * file = cache->GetResource<XMLFile>(resourceName);
+
+	if (!file)
+	{
+		log_->Write(LOG_ERROR, "Could not load weapon definitions: " + resourceName);
+		return false;
+	}
+
+	XMLElement root = file->GetRoot("weapons");
+	weaponDefs_.Clear();
+
+	for (XMLElement element = root.GetChild("weapon"); element; element = element.GetNext("weapon"))
+	{
+		WeaponDef def;
+		def.name_ = element.GetAttribute("name");
+
+		def.position_ = element.GetChild("position").GetVector3("value");
+		def.scale_ = element.GetChild("scale").GetVector3("value");
+		def.rotation_ = element.GetChild("rotation").GetQuaternion("value");
+		def.model_ = element.GetChild("model").GetAttribute("value");
+		def.material_ = element.GetChild("material").GetAttribute("value");
+		def.sound_ = element.GetChild("sound").GetAttribute("value");
+		def.shootingInterval_ = element.GetChild("shootingInterval").GetFloat("value");
+		def.maxSpreadTime_ = element.GetChild("maxSpreadTime").GetFloat("value");
+		def.spreadFactor_ = element.GetChild("spreadFactor").GetFloat("value");
+		def.automatic_ = element.GetChild("automatic").GetBool("value");
+		def.muzzlePosition_ = element.GetChild("muzzlePosition").GetVector3("value");
+		def.muzzleVelocity_ = element.GetChild("muzzleVelocity").GetFloat("value");
+		def.drag_ = element.GetChild("drag").GetFloat("value");
+		def.lightRotation_ = element.GetChild("lightRotation").GetQuaternion("value");
+		def.fireRotation_ = element.GetChild("fireRotation").GetQuaternion("value");
+
+		weaponDefs_.Push(def);
+	}
+
+	if (weaponDefs_.Empty())
+	{
+		log_->Write(LOG_ERROR, "No weapons defined in " + resourceName);
+		return false;
+	}
+
+	int primary = GetWeaponDefIndex(root.GetAttribute("primary"));
+	int secondary = GetWeaponDefIndex(root.GetAttribute("secondary"));
+
+	gameState_->primaryWeapon_ = primary >= 0 ? primary : 0;
+	gameState_->secondaryWeapon_ = secondary >= 0 ? secondary : (weaponDefs_.Size() > 1 ? 1 : 0);
+	gameState_->SetSelectedWeapon(gameState_->primaryWeapon_);
+
+	log_->Write(LOG_DEBUG, "Loaded weapon definitions: " + (String)weaponDefs_.Size());
+	return true;
+}
+
+int GetWeaponDefIndex(const String& name)
+{
+	for (unsigned int i = 0; i < weaponDefs_.Size(); i++)
+	{
+		if (weaponDefs_[i].name_ == name)
+			return i;
+	}
+
+	return -1;
+}
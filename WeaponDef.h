@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Urho3D/Container/Str.h>
+#include <Urho3D/Math/Quaternion.h>
+#include <Urho3D/Math/Vector3.h>
+
+namespace Urho3D
+{
+class Context;
+}
+
+using namespace Urho3D;
+
+/// Typed weapon definition. Loaded once from the weapon data file and addressed by its index in weaponDefs_.
+struct WeaponDef
+{
+	String name_;
+
+	Vector3 position_ = Vector3::ZERO;
+	Vector3 scale_ = Vector3::ONE;
+	Quaternion rotation_ = Quaternion::IDENTITY;
+
+	String model_;
+	String material_;
+	String sound_;
+
+	float shootingInterval_ = .1f;
+	float maxSpreadTime_ = 1.5f;
+	float spreadFactor_ = 75.0f;
+	bool automatic_ = false;
+
+	Vector3 muzzlePosition_ = Vector3::ZERO;
+	float muzzleVelocity_ = 400.0f;
+	float drag_ = .001f;
+
+	Quaternion lightRotation_ = Quaternion::IDENTITY;
+	Quaternion fireRotation_ = Quaternion::IDENTITY;
+};
+
+/// Fill weaponDefs_ from an XML resource and select the primary and secondary weapons listed in it.
+bool LoadWeaponDefs(Context * context, const String& resourceName);
+/// Return index of the named weapon in weaponDefs_, or -1 if it is not defined.
+int GetWeaponDefIndex(const String& name);